@@ -15,6 +15,7 @@
  * Basically, a cell on a grid either lives or dies based on it proximity to neighboring cells.
  * 
  * There are boundary cases which are covered in three modes: Plateau, Donut and Mirror.
+ * A fourth mode, Infinite, removes the edges altogether.
  * The game can be advanced manually or at three different simulation speeds.
  *
  */
@@ -28,25 +29,16 @@
 #include "vector.h"
 #include "lifeGrid.h"
 #include "lifeGraphics.h"
+#include "lifeFile.h"
+#include "lifeThreads.h"
+#include "lifeTrace.h"
 
 #include <iostream>
 #include <fstream>
+#include <cstdlib>
 
-const bool TEST_CASE = false;
-const bool TEST_RANDOM= true;
-const int TEST_SPEED = 4;
-const int TEST_MODE = 0;
-//const string TEST_FILE = "test33";
-//const string TEST_FILE = "simplebar";
-//const string TEST_FILE = "snowflake";
-//const string TEST_FILE = "StablePlateau";
-//const string TEST_FILE = "StableDonut";
-//const string TEST_FILE = "fish";
-//const string TEST_FILE = "Glider Explosion";
-const string TEST_FILE = "StableMirror";
-
-const int MAX_ROW = 70;
-const int MAX_COL = 90;
+const int SIM_THREADS = 0; // Workers stepping big grids; 0 uses one per processor
+const char *TRACE_VARIABLE = "LIFE_TRACE_FILE"; // If set, each simulation is traced to this file
 
 
 void Welcome();
@@ -54,29 +46,32 @@ bool AskForFile();
 bool AskForYesOrNo(string messageOut);
 
 gridLifeT GridStart(bool isGetFile);
-gridLifeT GetGridFromFile(ifstream &in1);
-
-void GetOneRow(string line, Grid<int> &theGrid, int currentRow);
-gridLifeT GenerateRandomGrid();
 int GetSimSpeed();
 int GetSimMode();
+simEngineT GetSimEngine();
 
 
 int main() {
+	SetWorkerCount(SIM_THREADS);
 	SetWindowTitle("Life!");
 	InitGraphics();
 	Welcome();
     while (true) {
+        const char *traceFile = getenv(TRACE_VARIABLE);
+        bool isTracing = (traceFile != NULL && StartTrace(traceFile));
         gridLifeT gridLife = GridStart(AskForFile());
-        if (TEST_CASE) {
-            RunLifeSim(TEST_MODE, TEST_SPEED, gridLife);
-        }
-        else {
-            RunLifeSim(GetSimMode(), GetSimSpeed(), gridLife);
+        int simMode = GetSimMode();
+        int simSpeed = GetSimSpeed();
+        RunLifeSim(simMode, simSpeed, gridLife, GetSimEngine());
+        if (isTracing) {
+            if (!StopTrace()) {
+                cout << "Unable to write the trace " << traceFile << endl;
+            }
+            PrintTraceSummary(cout);
         }
         bool anotherGame = AskForYesOrNo("\nWould you like to run another simulation? ");
         if (!anotherGame) {
-            if (!TEST_CASE) break;
+            break;
         }
     }
 	return 0;
@@ -107,19 +102,7 @@ bool AskForYesOrNo(string messageOut) {
     bool result = false;
     while (true) {
         cout << messageOut;
-        string line;
-        if (!TEST_CASE)
-            line = ConvertToLowerCase(GetLine());
-        else {
-            if (TEST_RANDOM) {
-                line = "no";
-                cout << "TEST_CASE: Answer is no" << endl;
-            }
-            else {
-                line = "yes";
-                cout << "TEST_CASE: Answer is yes" << endl;
-            }
-        }
+        string line = ConvertToLowerCase(GetLine());
         if (line[0] == 'y') {
             result = true;
             break;
@@ -141,24 +124,11 @@ gridLifeT GridStart(bool isGetFile) {
     if (isGetFile) {
         while (true) {
             cout << "Please enter the filename: ";
-            string filename;
-            if (!TEST_CASE)
-                filename = GetLine();
-            else {
-                filename = TEST_FILE;
-                cout << "TEST_CASE: filename is " <<  TEST_FILE << endl;
-            }
-            ifstream in1;
-            in1.open(filename.c_str());
-            if (in1.fail()) {
-                cout << "Unable to open the file named " << filename << ".  Please try again." << endl;
-                in1.clear();
-            }
-            else {
-                gridLife = GetGridFromFile(in1);
-                in1.close();
+            string filename = GetLine();
+            if (ReadGridFile(filename, gridLife)) {
                 break;
             }
+            cout << "Unable to open the file named " << filename << ".  Please try again." << endl;
         }
     }
     else {
@@ -170,75 +140,6 @@ gridLifeT GridStart(bool isGetFile) {
     return gridLife;
 }
 
-gridLifeT GetGridFromFile(ifstream &in1) {
-    gridLifeT gridLife;
-    Grid<int> theGrid;
-    gridSizeT gridSize;
-    bool gotRow = false;
-    int currentRow = 0;
-    
-    //cout << "Got a good file name" << endl;
-    
-    while (true) {
-        string line;
-        getline(in1,line);
-        if (in1.fail()) {
-            break;
-        }
-        if (line[0] == 'X' || line[0] == '-')  { // Parse for Grid
-            GetOneRow(line, theGrid, currentRow);
-            currentRow += 1;
-        }
-        else if (line[0] == '#') { // Ignore comments
-            
-        }
-        else { // Assume well-formed file (no error checking)
-            int param = StringToInteger(line);
-            if (gotRow) {
-                gridSize.col = param;
-                theGrid.resize(gridSize.row, gridSize.col);
-            }
-            else {
-                gridSize.row = param;
-                gotRow = true;
-            }
-        }
-    }
-    
-    gridLife = theGrid;
-    return gridLife;
-}
-
-void GetOneRow(string line, Grid<int> &theGrid, int currentRow) {
-    int numCols = theGrid.numCols();
-    
-    for (int i = 0; i < numCols; i++) {
-        int age = 0;
-        if (line[i] == 'X') {
-            age = 1;
-        }
-        theGrid[currentRow][i] = age;
-    }
-}
-
-gridLifeT GenerateRandomGrid() {
-    gridLifeT gridLife;
-    
-    //cout << "Random Grid Generation." << endl;
-    
-    gridLife.resize(MAX_ROW, MAX_COL);
-    
-    for (int i = 0; i < gridLife.numRows(); i++) {
-        for (int j = 0; j < gridLife.numCols(); j++) {
-            gridLife[i][j] = RandomInteger(0, 1);
-            if (gridLife[i][j] > 0) {
-                gridLife[i][j] = RandomInteger(1, 12);
-            }
-        }
-    }
-    return gridLife;
-}
-
 void PrintString(string message) {
     cout << "    " << message << endl;
 }
@@ -329,9 +230,23 @@ int GetSimMode() {
 	choices.add("P = Plateau Mode (cells on edges just have fewer neighbors)");
 	choices.add("D = Donut Mode (cells on edges wrap around to find neighbors)");
 	choices.add("M = Mirror Mode (cells on edge reflect back to find neighbors)");
+	choices.add("I = Infinite Mode (no edges; the colony can grow past the window)");
     return AskForChoice(messageOut, choices);
 }
 
+simEngineT GetSimEngine() {
+    string messageOut = "You choose which engine steps the simulation.\nInfinite Mode keeps its own live-cell engine unless you pick HashLife.";
+    Vector<string> choices;
+    choices.add("S = Standard engine (whole rows per vector instruction, changed tiles only, on every core)");
+    choices.add("B = Bit-packed engine (64 cells at a time, best for big grids)");
+    choices.add("H = HashLife engine (unbounded plane, edges are ignored)");
+    switch (AskForChoice(messageOut, choices)) {
+        case 1: return BitEngine;
+        case 2: return HashEngine;
+        default: return DenseEngine;
+    }
+}
+
 
 
 
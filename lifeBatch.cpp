@@ -0,0 +1,554 @@
+//
+//  lifeBatch.cpp
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+/*
+ * lifeBatch runs a simulation without graphics or prompts, for scripts
+ * and job schedulers.  It loads a pattern file, plaintext or RLE (or
+ * seeds a random grid), steps it for the requested number of generations
+ * as fast as the engine allows, and prints the final grid as a pattern
+ * file, preceded by comment lines giving the generation reached, the
+ * population and the wall time spent stepping.
+ *
+ *     lifeBatch [options] <pattern file>
+ *
+ *     --generations N     generations to run (default 100)
+ *     --mode P|D|M|I      Plateau, Donut, Mirror or Infinite (default P)
+ *     --engine S|B|H      Standard, Bit-packed or HashLife (default S);
+ *                         HashLife only runs in Infinite mode, its default
+ *     --step-log K        HashLife steps 2^K generations at a time
+ *     --threads N         workers stepping big grids; 0 uses one per processor
+ *     --random            seed a random grid instead of reading a file
+ *     --seed N            seed for --random
+ *     --quiet             report without printing the final grid
+ *     --rle               print the final grid as RLE (the default for .rle input)
+ *     --frame FILE        also save the final grid as a .bmp picture
+ *     --scale N           pixels per cell in the picture (default 4)
+ *     --checkpoint FILE   save a snapshot of the run to FILE periodically
+ *                         and when it ends
+ *     --checkpoint-every N generations between checkpoints (default 10000)
+ *     --resume FILE       continue the run saved in snapshot FILE
+ *     --census N          run a census of N random soups instead (see
+ *                         lifeCensus.h), seeded by --seed
+ *     --soup-size N       soups are N cells square (default 16)
+ *     --bench FILE        run the engine benchmarks instead (see lifeBench.h)
+ *                         and save the results to FILE, as CSV if it ends
+ *                         in .csv and as JSON otherwise
+ *     --repeats N         times each benchmark is repeated (default 5)
+ *     --bench-max N       largest random grid benchmarked (default 16384)
+ *     --pattern-dir DIR   where the bundled patterns are (default .)
+ *     --latency           print how long generations took to step: the
+ *                         mean, p50, p90, p99, p99.9 and longest
+ *     --perf              count cycles, instructions, cache misses and branch
+ *                         misses while stepping (Linux only, see lifePerf.h)
+ *                         and print them per cell; steps on one thread
+ *     --trace FILE        time the step, load and checkpoint phases (see
+ *                         lifeTrace.h), save them to FILE as Chrome trace
+ *                         JSON and print a summary after the report
+ *
+ * The run ends early, as in the game, once the colony stabilizes: dies
+ * out, or settles into a still life, an oscillator or a spaceship.  A
+ * resumed run keeps its generation count, so giving it the same
+ * --generations finishes at the same generation as the original would.
+ *
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <sys/time.h>
+
+#include "genlib.h"
+#include "grid.h"
+
+#include "lifeGrid.h"
+#include "lifeSim.h"
+#include "lifeFile.h"
+#include "lifeThreads.h"
+#include "lifeGraphics.h"
+#include "lifeRle.h"
+#include "lifeMap.h"
+#include "lifeSnapshot.h"
+#include "lifeCensus.h"
+#include "lifeBench.h"
+#include "lifeTrace.h"
+#include "lifeLatency.h"
+#include "lifePerf.h"
+
+// genlib.h renames main so the cs106 library can start the graphics first.
+// The batch runner needs neither the graphics nor the library's main, but
+// does need argv.
+#undef main
+
+struct batchOptionsT {
+    string filename;
+    long long generations;
+    int simMode;
+    simEngineT engine;
+    int stepLog;
+    int threads;
+    bool random;
+    int seed;
+    bool quiet;
+    string frameFile;
+    int scale;
+    bool rle;
+    string checkpointFile;
+    long long checkpointEvery;
+    string resumeFile;
+    long long census;
+    int soupSize;
+    string benchFile;
+    int repeats;
+    int benchMax;
+    string patternDir;
+    string traceFile;
+    bool latency;
+    bool perf;
+};
+
+static bool ParseOptions(int argc, char *argv[], batchOptionsT &options);
+static bool LoadSim(batchOptionsT &options, lifeSimT &sim, gridLifeT &gridLife);
+static gridLifeT &OutputGrid(lifeSimT &sim);
+static int RunCensusBatch(batchOptionsT &options);
+static int RunBenchBatch(batchOptionsT &options);
+static void FinishTrace(batchOptionsT &options);
+static double StepCells(lifeSimT &sim);
+static void Usage();
+static double WallSeconds();
+
+int main(int argc, char *argv[]) {
+    batchOptionsT options;
+    if (!ParseOptions(argc, argv, options)) {
+        Usage();
+        return 2;
+    }
+    SetWorkerCount(options.perf ? 1 : options.threads);   // counters only follow this thread
+    if (!options.traceFile.empty() && !StartTrace(options.traceFile)) {
+        cerr << "lifeBatch: built without tracing (LIFE_TRACE is 0)" << endl;
+        return 1;
+    }
+    if (options.census > 0) {
+        int status = RunCensusBatch(options);
+        FinishTrace(options);
+        return status;
+    }
+    if (!options.benchFile.empty()) {
+        int status = RunBenchBatch(options);
+        FinishTrace(options);
+        return status;
+    }
+
+    gridLifeT gridLife;
+    lifeSimT sim;
+    if (!LoadSim(options, sim, gridLife)) {
+        return 1;
+    }
+    sim.stepLog = options.stepLog;
+    checkpointT checkpoint;
+    InitCheckpoint(checkpoint, options.checkpointFile, options.checkpointFile.empty() ? 0 : options.checkpointEvery, sim);
+
+    latencyT stepTimes;
+    InitLatency(stepTimes);
+    perfCountersT counters;
+    perfTotalsT stepCounts;
+    InitPerfTotals(stepCounts);
+    if (options.perf && !OpenPerfCounters(counters)) {
+        cerr << "lifeBatch: hardware performance counters are not available here" << endl;
+        options.perf = false;
+    }
+    double cells = StepCells(sim);
+    bool isStabilized = !options.resumeFile.empty() && sim.cycle.kind != NoCycle;   // saved as it stopped
+    double start = WallSeconds();
+    while (sim.generation < options.generations && !isStabilized) {
+        if (sim.engine == HashEngine && sim.generation + (int64_t(1) << sim.stepLog) > options.generations) {
+            while (sim.stepLog > 0 && sim.generation + (int64_t(1) << sim.stepLog) > options.generations) {
+                sim.stepLog--;      // take smaller steps to land exactly on --generations
+            }
+            cells = StepCells(sim);
+        }
+        int64_t began = options.latency ? TraceClock() : 0;
+        if (options.perf) BeginPerf(counters);
+        isStabilized = StepSim(sim);
+        if (options.perf) EndPerf(counters, stepCounts, cells);
+        if (options.latency) RecordLatency(stepTimes, TraceClock() - began);
+        Checkpoint(checkpoint, sim);
+    }
+    double elapsed = WallSeconds() - start;
+    if (!options.checkpointFile.empty() && !SaveSnapshot(sim, options.checkpointFile)) {
+        cerr << "lifeBatch: unable to write " << options.checkpointFile << endl;
+    }
+
+    cout << "# generation " << sim.generation << (isStabilized ? " (colony stabilized: " + SimVerdict(sim) + ")" : "") << endl;
+    cout << "# population " << (long long) SimPopulation(sim) << endl;
+    cout << "# wall time " << elapsed << " s" << endl;
+    if (options.latency) {
+        cout << "# ";
+        PrintLatency(cout, "step", stepTimes);
+    }
+    if (options.perf) {
+        cout << "# ";
+        PrintPerf(cout, "step", counters, stepCounts);
+        ClosePerfCounters(counters);
+    }
+    FinishTrace(options);
+    if (!options.quiet) {
+        if (!options.rle) {
+            WriteGrid(cout, OutputGrid(sim));
+        }
+        else if (sim.engine == SparseEngine) {
+            WriteRleSparse(cout, sim.sparse);
+        }
+        else if (sim.engine == HashEngine) {
+            sparseLifeT cells;
+            if (!HashLifeToSparse(sim.hash, cells)) {
+                cerr << "lifeBatch: the pattern has spread too far to write as RLE" << endl;
+                return 1;
+            }
+            WriteRleSparse(cout, cells);
+        }
+        else {
+            WriteRle(cout, OutputGrid(sim));
+        }
+    }
+    if (!options.frameFile.empty()) {
+        gridLifeT &output = OutputGrid(sim);
+        frameBufferT frame;
+        InitFrameBuffer(frame, output.numRows(), output.numCols(), options.scale);
+        RenderFrame(frame, output);
+        if (!WriteFrameBMP(frame, options.frameFile)) {
+            cerr << "lifeBatch: unable to write " << options.frameFile << endl;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Runs the census and prints its table, headed by the throughput in soups
+ * per second for each worker thread.
+ */
+
+static int RunCensusBatch(batchOptionsT &options) {
+    uint64_t seed = (options.seed >= 0) ? options.seed : (uint64_t) time(NULL);
+    censusT census;
+    InitCensus(census);
+    double start = WallSeconds();
+    RunCensus(census, seed, 0, options.census, options.soupSize);
+    double elapsed = WallSeconds() - start;
+    cout << "# census of " << census.soups << " soups, " << options.soupSize << "x" << options.soupSize
+         << ", seed " << seed << endl;
+    cout << "# wall time " << elapsed << " s on " << WorkerCount() << " threads, "
+         << census.soups / elapsed / WorkerCount() << " soups/s/core" << endl;
+    PrintCensus(cout, census);
+    return 0;
+}
+
+/*
+ * Runs the benchmarks, printing each result as it comes, and saves them.
+ */
+
+static int RunBenchBatch(batchOptionsT &options) {
+    benchOptionsT bench;
+    bench.patternDir = options.patternDir;
+    bench.maxSize = options.benchMax;
+    bench.repeats = options.repeats;
+    bench.seed = (options.seed >= 0) ? options.seed : 0;
+    std::vector<benchResultT> results;
+    RunBenchmarks(bench, results, cout);
+
+    ofstream out(options.benchFile.c_str());
+    if (out.fail()) {
+        cerr << "lifeBatch: unable to write " << options.benchFile << endl;
+        return 1;
+    }
+    string extension = ".csv";
+    size_t n = options.benchFile.size();
+    if (n > extension.size() && options.benchFile.substr(n - extension.size()) == extension) {
+        WriteBenchCSV(out, results);
+    }
+    else {
+        WriteBenchJSON(out, bench, results);
+    }
+    return 0;
+}
+
+/*
+ * Returns the cells each step works out: the board, times the generations
+ * a HashLife step covers.  For HashLife and Infinite Mode only the window
+ * is counted.
+ */
+
+static double StepCells(lifeSimT &sim) {
+    switch (sim.engine) {
+        case BitEngine:
+            return double(sim.bits.nRows) * sim.bits.nCols;
+        case SparseEngine:
+            return double(sim.sparse.nRows) * sim.sparse.nCols;
+        case HashEngine:
+            return double(sim.gridLife->numRows()) * sim.gridLife->numCols() * (int64_t(1) << sim.stepLog);
+        default:
+            return double(sim.dense.nRows) * sim.dense.nCols;
+    }
+}
+
+/*
+ * Saves the trace, if one is running, and prints its summary as comment
+ * lines.
+ */
+
+static void FinishTrace(batchOptionsT &options) {
+    if (options.traceFile.empty()) return;
+    if (!StopTrace()) {
+        cerr << "lifeBatch: unable to write " << options.traceFile << endl;
+    }
+    PrintTraceSummary(cout);
+}
+
+/*
+ * Loads the starting pattern, or the snapshot to resume, and sets up sim
+ * to step it.  A snapshot brings its own engine and simMode.  RLE patterns for
+ * the bit-packed engine or Infinite Mode, and plaintext patterns for the
+ * bit-packed engine, are decoded straight into the engine, and gridLife is
+ * left empty until OutputGrid needs it.
+ */
+
+static bool LoadSim(batchOptionsT &options, lifeSimT &sim, gridLifeT &gridLife) {
+    if (!options.resumeFile.empty()) {
+        if (!LoadSnapshot(options.resumeFile, sim, gridLife)) {
+            cerr << "lifeBatch: unable to resume from " << options.resumeFile << endl;
+            return false;
+        }
+        return true;
+    }
+    if (options.random) {
+        if (options.seed >= 0) {
+            SeedGridRandom(options.seed);
+        }
+        gridLife = GenerateRandomGrid();
+        InitSim(sim, gridLife, options.simMode, options.engine);
+        return true;
+    }
+    bool infinite = (options.simMode == 3 && options.engine != HashEngine);
+    if (IsRleFile(options.filename) && (infinite || options.engine == BitEngine)) {
+        ifstream in1(options.filename.c_str());
+        if (in1.fail()) {
+            cerr << "lifeBatch: unable to open the file named " << options.filename << endl;
+            return false;
+        }
+        bool ok = infinite ? ReadRleSparse(in1, sim.sparse) : ReadRleBits(in1, sim.bits, options.simMode);
+        if (!ok) {
+            cerr << "lifeBatch: malformed RLE pattern in " << options.filename << endl;
+            return false;
+        }
+        InitSimLoaded(sim, gridLife, options.simMode, infinite ? SparseEngine : BitEngine);
+        return true;
+    }
+    if (!IsRleFile(options.filename) && options.engine == BitEngine && !infinite) {
+        if (!MapGridFileBits(options.filename, sim.bits, options.simMode)) {
+            cerr << "lifeBatch: unable to open the file named " << options.filename << endl;
+            return false;
+        }
+        InitSimLoaded(sim, gridLife, options.simMode, BitEngine);
+        return true;
+    }
+    if (!ReadGridFile(options.filename, gridLife)) {
+        cerr << "lifeBatch: unable to open the file named " << options.filename << endl;
+        return false;
+    }
+    InitSim(sim, gridLife, options.simMode, options.engine);
+    return true;
+}
+
+/*
+ * Sizes the window to the pattern if a loader left it empty, then exports
+ * the current generation into it.
+ */
+
+static gridLifeT &OutputGrid(lifeSimT &sim) {
+    gridLifeT &gridLife = *sim.gridLife;
+    if (gridLife.numRows() == 0 && gridLife.numCols() == 0) {
+        if (sim.engine == BitEngine) {
+            gridLife.resize(sim.bits.nRows, sim.bits.nCols);
+        }
+        else if (sim.engine == SparseEngine) {
+            gridLife.resize(sim.sparse.nRows, sim.sparse.nCols);
+        }
+    }
+    return SimGrid(sim);
+}
+
+/*
+ * Returns the index of choice in letters ("PDMI" for modes), or -1.
+ */
+
+static int LetterChoice(const char *arg, const char *letters) {
+    const char *found = strchr(letters, toupper(arg[0]));
+    return (arg[0] != '\0' && found != NULL) ? found - letters : -1;
+}
+
+static bool ParseOptions(int argc, char *argv[], batchOptionsT &options) {
+    options.generations = 100;
+    options.simMode = -1;       // Plateau, or Infinite for HashLife, unless --mode says
+    options.engine = DenseEngine;
+    options.stepLog = 0;
+    options.threads = 0;
+    options.random = false;
+    options.seed = -1;
+    options.quiet = false;
+    options.scale = 4;
+    options.rle = false;
+    options.latency = false;
+    options.perf = false;
+    options.checkpointEvery = 10000;
+    options.census = 0;
+    options.soupSize = CensusSoupSize;
+    options.repeats = 5;
+    options.benchMax = BenchMaxSize;
+    options.patternDir = ".";
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--random") {
+            options.random = true;
+        }
+        else if (arg == "--quiet") {
+            options.quiet = true;
+        }
+        else if (arg == "--rle") {
+            options.rle = true;
+        }
+        else if (arg == "--latency") {
+            options.latency = true;
+        }
+        else if (arg == "--perf") {
+            options.perf = true;
+        }
+        else if (arg[0] != '-') {
+            options.filename = arg;
+        }
+        else if (!hasValue) {
+            return false;
+        }
+        else if (arg == "--generations") {
+            options.generations = atoll(argv[++i]);
+        }
+        else if (arg == "--mode") {
+            options.simMode = LetterChoice(argv[++i], "PDMI");
+            if (options.simMode < 0) return false;
+        }
+        else if (arg == "--engine") {
+            int engine = LetterChoice(argv[++i], "SBH");
+            if (engine < 0) return false;
+            options.engine = (engine == 1) ? BitEngine : (engine == 2) ? HashEngine : DenseEngine;
+        }
+        else if (arg == "--step-log") {
+            options.stepLog = atoi(argv[++i]);
+            if (options.stepLog < 0 || options.stepLog > 62) return false;   // 2^K must fit in a generation count
+        }
+        else if (arg == "--threads") {
+            options.threads = atoi(argv[++i]);
+        }
+        else if (arg == "--seed") {
+            options.seed = atoi(argv[++i]);
+        }
+        else if (arg == "--frame") {
+            options.frameFile = argv[++i];
+        }
+        else if (arg == "--scale") {
+            options.scale = atoi(argv[++i]);
+            if (options.scale < 1) return false;
+        }
+        else if (arg == "--checkpoint") {
+            options.checkpointFile = argv[++i];
+        }
+        else if (arg == "--checkpoint-every") {
+            options.checkpointEvery = atoll(argv[++i]);
+            if (options.checkpointEvery < 1) return false;
+        }
+        else if (arg == "--resume") {
+            options.resumeFile = argv[++i];
+        }
+        else if (arg == "--census") {
+            options.census = atoll(argv[++i]);
+            if (options.census < 1) return false;
+        }
+        else if (arg == "--bench") {
+            options.benchFile = argv[++i];
+        }
+        else if (arg == "--repeats") {
+            options.repeats = atoi(argv[++i]);
+            if (options.repeats < 1) return false;
+        }
+        else if (arg == "--bench-max") {
+            options.benchMax = atoi(argv[++i]);
+        }
+        else if (arg == "--pattern-dir") {
+            options.patternDir = argv[++i];
+        }
+        else if (arg == "--trace") {
+            options.traceFile = argv[++i];
+        }
+        else if (arg == "--soup-size") {
+            options.soupSize = atoi(argv[++i]);
+            if (options.soupSize < 1) return false;
+        }
+        else {
+            return false;
+        }
+    }
+    if (options.engine == HashEngine) {
+        if (options.simMode >= 0 && options.simMode != 3) {
+            cerr << "lifeBatch: HashLife has no edges, so it only runs in --mode I" << endl;
+            return false;
+        }
+        options.simMode = 3;
+    }
+    else if (options.simMode < 0) {
+        options.simMode = 0;
+    }
+    if (IsRleFile(options.filename)) {
+        options.rle = true;
+    }
+    return options.random || !options.filename.empty() || !options.resumeFile.empty() || options.census > 0 || !options.benchFile.empty();
+}
+
+static void Usage() {
+    cerr << "usage: lifeBatch [options] <pattern file>" << endl;
+    cerr << "       lifeBatch [options] --resume <snapshot file>" << endl;
+    cerr << "    --generations N     generations to run (default 100)" << endl;
+    cerr << "    --mode P|D|M|I      Plateau, Donut, Mirror or Infinite (default P)" << endl;
+    cerr << "    --engine S|B|H      Standard, Bit-packed or HashLife (default S); HashLife needs --mode I" << endl;
+    cerr << "    --step-log K        HashLife steps 2^K generations at a time" << endl;
+    cerr << "    --threads N         workers for big grids; 0 uses one per processor" << endl;
+    cerr << "    --random            seed a random grid instead of reading a file" << endl;
+    cerr << "    --seed N            seed for --random" << endl;
+    cerr << "    --quiet             report without printing the final grid" << endl;
+    cerr << "    --rle               print the final grid as RLE (the default for .rle input)" << endl;
+    cerr << "    --frame FILE        also save the final grid as a .bmp picture" << endl;
+    cerr << "    --scale N           pixels per cell in the picture (default 4)" << endl;
+    cerr << "    --checkpoint FILE   save a snapshot of the run to FILE periodically and at the end" << endl;
+    cerr << "    --checkpoint-every N generations between checkpoints (default 10000)" << endl;
+    cerr << "    --resume FILE       continue the run saved in snapshot FILE" << endl;
+    cerr << "    --census N          run a census of N random soups instead, seeded by --seed" << endl;
+    cerr << "    --soup-size N       soups are N cells square (default 16)" << endl;
+    cerr << "    --bench FILE        run the engine benchmarks instead, saving CSV or JSON to FILE" << endl;
+    cerr << "    --repeats N         times each benchmark is repeated (default 5)" << endl;
+    cerr << "    --bench-max N       largest random grid benchmarked (default 16384)" << endl;
+    cerr << "    --pattern-dir DIR   where the bundled patterns are (default .)" << endl;
+    cerr << "    --latency           print the p50, p99 and longest step times" << endl;
+    cerr << "    --perf              print cycles, IPC and cache and branch misses per cell (Linux)" << endl;
+    cerr << "    --trace FILE        save a Chrome trace of the run's phases to FILE and print a summary" << endl;
+}
+
+static double WallSeconds() {
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return now.tv_sec + now.tv_usec / 1e6;
+}
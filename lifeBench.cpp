@@ -0,0 +1,198 @@
+//
+//  lifeBench.cpp
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "genlib.h"
+#include "grid.h"
+
+#include "lifeBench.h"
+#include "lifeSim.h"
+#include "lifeFile.h"
+#include "lifeKernel.h"
+#include "lifeThreads.h"
+
+const double BenchWork = 1 << 26;          // cell generations each repeat aims for
+const int BenchMinGenerations = 4;
+const int BenchMaxGenerations = 10000;
+const int BenchHashMaxSize = 1024;          // largest random grid for HashLife
+const int BenchSparseMaxSize = 4096;        // largest random grid for the live-cell engine
+
+static const char *BenchPatterns[] = {
+    "Diehard", "Dinner Table", "Fish", "Flower", "Glider", "Glider Explosion",
+    "Glider Gun", "Quilt Square", "Seeds", "SimpleBar", "Snowflake", "Spiral",
+    "StableDonut", "StableMirror", "StablePlateau", "TicTacToe"
+};
+
+/*
+ * The engine and simMode of each case, as InitSim takes them.
+ */
+
+struct benchSetupT {
+    simEngineT engine;
+    int simMode;
+    const char *engineName;
+    const char *modeName;
+};
+
+static const benchSetupT BenchSetups[] = {
+    { DenseEngine, 0, "standard", "plateau" },
+    { DenseEngine, 1, "standard", "donut" },
+    { DenseEngine, 2, "standard", "mirror" },
+    { BitEngine, 0, "bit-packed", "plateau" },
+    { BitEngine, 1, "bit-packed", "donut" },
+    { BitEngine, 2, "bit-packed", "mirror" },
+    { SparseEngine, 3, "live-cell", "infinite" },
+    { HashEngine, 3, "hashlife", "infinite" }
+};
+
+static double BenchSeconds() {
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return now.tv_sec + now.tv_usec / 1e6;
+}
+
+/*
+ * Times one case: the same start, stepped the same number of generations,
+ * repeats times over.  Only the engine is stepped, so the cycle watcher's
+ * work is not counted.
+ */
+
+static void RunCase(benchOptionsT &options, string pattern, gridLifeT &start, const benchSetupT &setup,
+                    std::vector<benchResultT> &results, ostream &progress) {
+    double cells = double(start.numRows()) * start.numCols();
+    int64_t generations = (int64_t) (BenchWork / cells);
+    generations = std::max<int64_t>(BenchMinGenerations, std::min<int64_t>(BenchMaxGenerations, generations));
+
+    std::vector<double> times;
+    for (int r = 0; r < options.repeats; r++) {
+        lifeSimT sim;
+        InitSim(sim, start, setup.simMode, setup.engine);   // only read, as SimGrid is never called
+        double began = BenchSeconds();
+        while (sim.generation < generations) {
+            StepEngine(sim);
+        }
+        times.push_back(BenchSeconds() - began);
+    }
+    std::sort(times.begin(), times.end());
+    double mean = 0, variance = 0;
+    for (size_t k = 0; k < times.size(); k++) mean += times[k] / times.size();
+    for (size_t k = 0; k < times.size(); k++) variance += (times[k] - mean) * (times[k] - mean) / times.size();
+
+    benchResultT result;
+    result.pattern = pattern;
+    result.nRows = start.numRows();
+    result.nCols = start.numCols();
+    result.engine = setup.engineName;
+    result.mode = setup.modeName;
+    result.generations = generations;
+    result.repeats = options.repeats;
+    size_t mid = times.size() / 2;
+    result.median = (times.size() % 2) ? times[mid] : (times[mid - 1] + times[mid]) / 2;
+    result.fastest = times.front();
+    result.slowest = times.back();
+    result.deviation = sqrt(variance);
+    double median = std::max(result.median, 1e-9);
+    result.gensPerSec = generations / median;
+    result.cellsPerSec = generations * cells / median;
+    result.nsPerCell = median * 1e9 / (generations * cells);
+    results.push_back(result);
+
+    char line[256];
+    sprintf(line, "%-18s %6dx%-6d %-10s %-8s %7lld gens  %10.0f gens/s  %9.3g cells/s  %7.3f ns/cell (+-%.1f%%)",
+            pattern.c_str(), result.nRows, result.nCols, setup.engineName, setup.modeName,
+            (long long) generations, result.gensPerSec, result.cellsPerSec, result.nsPerCell,
+            100 * result.deviation / median);
+    progress << line << endl;
+}
+
+void RunBenchmarks(benchOptionsT &options, std::vector<benchResultT> &results, ostream &progress) {
+    int nSetups = sizeof BenchSetups / sizeof BenchSetups[0];
+    int nPatterns = sizeof BenchPatterns / sizeof BenchPatterns[0];
+    for (int p = 0; p < nPatterns; p++) {
+        gridLifeT start;
+        string filename = options.patternDir + "/" + BenchPatterns[p];
+        if (!ReadGridFile(filename, start)) {
+            progress << "skipping " << filename << ": unable to open" << endl;
+            continue;
+        }
+        for (int s = 0; s < nSetups; s++) {
+            RunCase(options, BenchPatterns[p], start, BenchSetups[s], results, progress);
+        }
+    }
+    SeedGridRandom(options.seed);
+    for (int size = BenchMinSize; size <= options.maxSize; size *= 4) {
+        gridLifeT start = GenerateRandomGrid(size, size);
+        for (int s = 0; s < nSetups; s++) {
+            const benchSetupT &setup = BenchSetups[s];
+            if (setup.engine == HashEngine && size > BenchHashMaxSize) continue;
+            if (setup.engine == SparseEngine && size > BenchSparseMaxSize) continue;
+            RunCase(options, "random", start, setup, results, progress);
+        }
+    }
+}
+
+/*
+ * JSON strings only need their quotes and backslashes escaped here.
+ */
+
+static string JsonString(string text) {
+    string quoted = "\"";
+    for (size_t k = 0; k < text.size(); k++) {
+        if (text[k] == '"' || text[k] == '\\') quoted += '\\';
+        quoted += text[k];
+    }
+    return quoted + "\"";
+}
+
+void WriteBenchJSON(ostream &out, benchOptionsT &options, std::vector<benchResultT> &results) {
+    char host[256] = "";
+    gethostname(host, sizeof host - 1);
+    char when[32];
+    time_t now = time(NULL);
+    strftime(when, sizeof when, "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+    out.precision(6);
+    out << "{" << endl;
+    out << "  \"date\": " << JsonString(when) << "," << endl;
+    out << "  \"host\": " << JsonString(host) << "," << endl;
+    out << "  \"workers\": " << WorkerCount() << "," << endl;
+    out << "  \"simd\": " << JsonString(SimdLevelName(BestSimdLevel())) << "," << endl;
+    out << "  \"repeats\": " << options.repeats << "," << endl;
+    out << "  \"seed\": " << options.seed << "," << endl;
+    out << "  \"results\": [" << endl;
+    for (size_t k = 0; k < results.size(); k++) {
+        benchResultT &r = results[k];
+        out << "    {\"pattern\": " << JsonString(r.pattern) << ", \"rows\": " << r.nRows << ", \"cols\": " << r.nCols
+            << ", \"engine\": " << JsonString(r.engine) << ", \"mode\": " << JsonString(r.mode)
+            << ", \"generations\": " << r.generations << ", \"repeats\": " << r.repeats
+            << ", \"seconds\": {\"median\": " << r.median << ", \"min\": " << r.fastest << ", \"max\": " << r.slowest
+            << ", \"stddev\": " << r.deviation << "}"
+            << ", \"gens_per_sec\": " << r.gensPerSec << ", \"cells_per_sec\": " << r.cellsPerSec
+            << ", \"ns_per_cell\": " << r.nsPerCell << "}" << ((k + 1 < results.size()) ? "," : "") << endl;
+    }
+    out << "  ]" << endl;
+    out << "}" << endl;
+}
+
+void WriteBenchCSV(ostream &out, std::vector<benchResultT> &results) {
+    out.precision(6);
+    out << "pattern,rows,cols,engine,mode,generations,repeats,median_s,min_s,max_s,stddev_s,"
+        << "gens_per_sec,cells_per_sec,ns_per_cell" << endl;
+    for (size_t k = 0; k < results.size(); k++) {
+        benchResultT &r = results[k];
+        out << "\"" << r.pattern << "\"," << r.nRows << "," << r.nCols << "," << r.engine << "," << r.mode << ","
+            << r.generations << "," << r.repeats << "," << r.median << "," << r.fastest << "," << r.slowest << ","
+            << r.deviation << "," << r.gensPerSec << "," << r.cellsPerSec << "," << r.nsPerCell << endl;
+    }
+}
@@ -0,0 +1,80 @@
+//
+//  lifeBench.h
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+/*
+ * A repeatable benchmark of the stepping engines, so their speed can be
+ * tracked from one change to the next.
+ *
+ * Every bundled pattern file, and random grids from 64 x 64 up to
+ * 16384 x 16384 (growing four times per side each step), is stepped on
+ * each engine in each simMode it supports: the standard and bit-packed
+ * engines in Plateau, Donut and Mirror, the live-cell engine and HashLife
+ * on the unbounded plane.  HashLife and the live-cell engine keep every
+ * random cell, so their random grids stop at smaller sizes.
+ *
+ * Each case steps a fixed number of generations, chosen so a run does
+ * about the same work whatever the grid size, and is repeated from the
+ * same start several times.  Setting the case up is not timed, and the
+ * run carries on past stabilization so every repeat does the same work.
+ * Only the engine's own step is timed, without the cycle watching StepSim
+ * adds on top, so the rates are the engines' throughput alone.
+ * Rates are worked out from the median time, over the window's cells.
+ *
+ */
+
+#ifndef life_lifeBench_h
+#define life_lifeBench_h
+
+#include <stdint.h>
+#include <iostream>
+#include <vector>
+
+#include "genlib.h"
+
+const int BenchMinSize = 64;
+const int BenchMaxSize = 16384;
+
+struct benchOptionsT {
+    string patternDir;      // where the bundled pattern files are
+    int maxSize;            // largest random grid, cells per side
+    int repeats;
+    uint64_t seed;          // for the random grids
+};
+
+struct benchResultT {
+    string pattern;         // file name, or "random"
+    int nRows;
+    int nCols;
+    string engine;
+    string mode;
+    int64_t generations;    // per repeat
+    int repeats;
+    double median;          // seconds per repeat
+    double fastest;
+    double slowest;
+    double deviation;       // standard deviation
+    double gensPerSec;
+    double cellsPerSec;
+    double nsPerCell;
+};
+
+/*
+ * Runs every case, adding its result to results and printing a line for
+ * each to progress as it finishes.
+ */
+
+void RunBenchmarks(benchOptionsT &options, std::vector<benchResultT> &results, ostream &progress);
+
+/*
+ * Write the results as a JSON document or as CSV with a header row.
+ */
+
+void WriteBenchJSON(ostream &out, benchOptionsT &options, std::vector<benchResultT> &results);
+void WriteBenchCSV(ostream &out, std::vector<benchResultT> &results);
+
+#endif
@@ -0,0 +1,299 @@
+//
+//  lifeBits.cpp
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+#include "genlib.h"
+#include "grid.h"
+
+#include "lifeBits.h"
+
+#define MIN(x, y) ((x) < (y) ? (x) : (y))
+
+static void SettleAges(bitGridT &bits);
+static const bitWordT *RowAt(bitGridT &bits, std::vector<bitWordT> &plane, int row);
+static void EdgeBits(bitGridT &bits, const bitWordT *row, bitWordT &west, bitWordT &east);
+
+void InitBitGrid(bitGridT &bits, gridLifeT &gridLife, int simMode) {
+    ResizeBitGrid(bits, gridLife.numRows(), gridLife.numCols(), simMode);
+
+    std::vector<bitWordT> &live = bits.live[0];
+    for (int i = 0; i < bits.nRows; i++) {
+        for (int j = 0; j < bits.nCols; j++) {
+            int age = gridLife[i][j];
+            if (age > 0) {
+                live[i * bits.wordsPerRow + j / BitsPerWord] |= bitWordT(1) << (j % BitsPerWord);
+                SetBitCellAge(bits, i, j, MIN(age, MaxAge));
+            }
+        }
+    }
+    bits.agesPending = false;   // every cell got its age above
+}
+
+void ResizeBitGrid(bitGridT &bits, int nRows, int nCols, int simMode) {
+    bits.nRows = nRows;
+    bits.nCols = nCols;
+    bits.wordsPerRow = (bits.nCols + BitsPerWord - 1) / BitsPerWord;
+    bits.simMode = simMode;
+    bits.generation = 0;
+    bits.current = 0;
+    bits.agesPending = true;    // so SettleAges gives every loaded cell age 1
+    for (int k = 0; k < 2; k++) {
+        bits.live[k].assign(bits.nRows * bits.wordsPerRow + bits.wordsPerRow, 0);
+    }
+    for (int k = 0; k < AgeBits; k++) {
+        bits.age[k].assign(bits.nRows * bits.wordsPerRow, 0);
+    }
+}
+
+void SetBitRun(bitGridT &bits, int row, int col, int length) {
+    bitWordT *words = &bits.live[bits.current][row * bits.wordsPerRow];
+    int end = col + length;
+    while (col < end) {
+        int bit = col % BitsPerWord;
+        int n = MIN(end - col, BitsPerWord - bit);
+        bitWordT mask = (n == BitsPerWord) ? ~bitWordT(0) : ((bitWordT(1) << n) - 1) << bit;
+        words[col / BitsPerWord] |= mask;
+        col += n;
+    }
+}
+
+bitWordT *BitRow(bitGridT &bits, int row) {
+    return &bits.live[bits.current][row * bits.wordsPerRow];
+}
+
+int BitCellAge(bitGridT &bits, int row, int col) {
+    SettleAges(bits);
+    int index = row * bits.wordsPerRow + col / BitsPerWord;
+    int bit = col % BitsPerWord;
+    int age = 0;
+    for (int k = 0; k < AgeBits; k++) {
+        age |= int((bits.age[k][index] >> bit) & 1) << k;
+    }
+    return age;
+}
+
+void SetBitCellAge(bitGridT &bits, int row, int col, int age) {
+    int index = row * bits.wordsPerRow + col / BitsPerWord;
+    bitWordT mask = bitWordT(1) << (col % BitsPerWord);
+    for (int k = 0; k < AgeBits; k++) {
+        if ((age >> k) & 1) {
+            bits.age[k][index] |= mask;
+        }
+        else {
+            bits.age[k][index] &= ~mask;
+        }
+    }
+}
+
+double BitGridPopulation(bitGridT &bits) {
+    std::vector<bitWordT> &live = bits.live[bits.current];
+    double population = 0;
+    for (int k = 0; k < bits.nRows * bits.wordsPerRow; k++) {
+        population += __builtin_popcountll(live[k]);
+    }
+    return population;
+}
+
+void BitGridToGrid(bitGridT &bits, gridLifeT &gridLife) {
+    SettleAges(bits);
+    for (int r = 0; r < bits.nRows; r++) {
+        for (int i = 0; i < bits.wordsPerRow; i++) {
+            int index = r * bits.wordsPerRow + i;
+            int first = i * BitsPerWord;
+            int last = MIN(first + BitsPerWord, bits.nCols);
+            for (int j = first; j < last; j++) {
+                int b = j - first;
+                int age = 0;
+                for (int k = 0; k < AgeBits; k++) {
+                    age |= int((bits.age[k][index] >> b) & 1) << k;
+                }
+                gridLife[r][j] = age;
+            }
+        }
+    }
+}
+
+/*
+ * WestOf and EastOf line each cell up with its left or right neighbor by
+ * shifting a whole word, pulling the bit that crosses the word boundary in
+ * from the adjacent word (or from the edge bit for the row's first and
+ * last words).  Bit j of a word holds column j, so "west" is a left shift.
+ */
+
+static inline bitWordT WestOf(const bitWordT *row, int i, bitWordT westEdge) {
+    return (row[i] << 1) | ((i > 0) ? (row[i - 1] >> (BitsPerWord - 1)) : westEdge);
+}
+
+static inline bitWordT EastOf(const bitWordT *row, int i, int nWords, bitWordT eastEdge, int lastBit) {
+    if (i + 1 < nWords) {
+        return (row[i] >> 1) | (row[i + 1] << (BitsPerWord - 1));
+    }
+    return (row[i] >> 1) | (eastEdge << lastBit);
+}
+
+/*
+ * Returns the cells of a word whose age, spread across the age planes,
+ * equals value.
+ */
+
+static inline bitWordT AgeIs(const bitWordT age[], int value) {
+    bitWordT match = ~bitWordT(0);
+    for (int k = 0; k < AgeBits; k++) {
+        match &= ((value >> k) & 1) ? age[k] : ~age[k];
+    }
+    return match;
+}
+
+/*
+ * Calculates the next generation into the other live plane.
+ * Each neighbor count is formed bitwise: the three cells above and the three
+ * below each go through a full adder, the two beside through a half adder,
+ * and those partial sums are added again.  Only "exactly 2" and "exactly 3"
+ * matter, so the count never has to be carried past the twos column.
+ *
+ * The ages are then brought along in place, as a counter across the age
+ * planes: survivors add one, with the carry held back wherever the age is
+ * already MaxAge, births start at 1 and every other cell drops to 0.
+ */
+
+bool StepBitGrid(bitGridT &bits) {
+    SettleAges(bits);
+    int next = 1 - bits.current;
+    std::vector<bitWordT> &cur = bits.live[bits.current];
+    std::vector<bitWordT> &out = bits.live[next];
+    int nWords = bits.wordsPerRow;
+    int lastBit = (bits.nCols - 1) % BitsPerWord;
+    bitWordT lastMask = (lastBit == BitsPerWord - 1) ? ~bitWordT(0) : ((bitWordT(1) << (lastBit + 1)) - 1);
+    bitWordT young = 0;
+
+    for (int r = 0; r < bits.nRows; r++) {
+        const bitWordT *up = RowAt(bits, cur, r - 1);
+        const bitWordT *mid = RowAt(bits, cur, r);
+        const bitWordT *down = RowAt(bits, cur, r + 1);
+        bitWordT upWest, upEast, midWest, midEast, downWest, downEast;
+        EdgeBits(bits, up, upWest, upEast);
+        EdgeBits(bits, mid, midWest, midEast);
+        EdgeBits(bits, down, downWest, downEast);
+        bitWordT *dst = &out[r * nWords];
+        bitWordT *ages[AgeBits];
+        for (int k = 0; k < AgeBits; k++) {
+            ages[k] = &bits.age[k][r * nWords];
+        }
+
+        for (int i = 0; i < nWords; i++) {
+            bitWordT uW = WestOf(up, i, upWest);
+            bitWordT uE = EastOf(up, i, nWords, upEast, lastBit);
+            bitWordT mW = WestOf(mid, i, midWest);
+            bitWordT mE = EastOf(mid, i, nWords, midEast, lastBit);
+            bitWordT dW = WestOf(down, i, downWest);
+            bitWordT dE = EastOf(down, i, nWords, downEast, lastBit);
+            bitWordT alive = mid[i];
+
+            bitWordT t0 = uW ^ up[i] ^ uE;                       // above: full adder
+            bitWordT t1 = (uW & up[i]) | (uE & (uW ^ up[i]));
+            bitWordT b0 = dW ^ down[i] ^ dE;                     // below: full adder
+            bitWordT b1 = (dW & down[i]) | (dE & (dW ^ down[i]));
+            bitWordT m0 = mW ^ mE;                               // beside: half adder
+            bitWordT m1 = mW & mE;
+
+            bitWordT ones = t0 ^ b0 ^ m0;                        // ones column
+            bitWordT c0 = (t0 & b0) | (m0 & (t0 ^ b0));
+            bitWordT u0 = t1 ^ b1 ^ m1;                          // twos column
+            bitWordT u1 = (t1 & b1) | (m1 & (t1 ^ b1));
+            bitWordT twosIsOne = (u0 ^ c0) & ~u1;                // twos column sums to exactly 1
+
+            bitWordT result = twosIsOne & (ones | alive);        // 3 is born or lives, 2 only lives
+            if (i == nWords - 1) {
+                result &= lastMask;
+            }
+            dst[i] = result;
+
+            bitWordT was[AgeBits], now[AgeBits];
+            for (int k = 0; k < AgeBits; k++) {
+                was[k] = ages[k][i];
+            }
+            bitWordT survivors = result & alive;
+            bitWordT carry = survivors & ~AgeIs(was, MaxAge);   // add one, holding at MaxAge
+            for (int k = 0; k < AgeBits; k++) {
+                now[k] = (was[k] & survivors) ^ carry;
+                carry &= was[k];
+            }
+            now[0] |= result & ~alive;                           // births start at 1
+            for (int k = 0; k < AgeBits; k++) {
+                ages[k][i] = now[k];
+            }
+            young |= result & ~AgeIs(now, MaxAge);
+        }
+    }
+    bits.current = next;
+    bits.generation++;
+    return young == 0;
+}
+
+/*
+ * Gives age 1 to every live cell a loader brought to life without an age.
+ */
+
+static void SettleAges(bitGridT &bits) {
+    if (!bits.agesPending) return;
+    std::vector<bitWordT> &live = bits.live[bits.current];
+    for (int k = 0; k < bits.nRows * bits.wordsPerRow; k++) {
+        bitWordT aged = 0;
+        for (int b = 0; b < AgeBits; b++) {
+            aged |= bits.age[b][k];
+        }
+        bits.age[0][k] |= live[k] & ~aged;
+    }
+    bits.agesPending = false;
+}
+
+/*
+ * Returns the row of plane seen at the given row index, applying the
+ * simMode for rows just off the top and bottom edges.  Plateau mode sees
+ * the all-zero row kept past the end of every plane.
+ */
+
+static const bitWordT *RowAt(bitGridT &bits, std::vector<bitWordT> &plane, int row) {
+    if (row < 0 || row >= bits.nRows) {
+        if (bits.simMode == 0) { // Plateau
+            row = bits.nRows;
+        }
+        else if (bits.simMode == 1) { // Donut
+            row = (row < 0) ? bits.nRows - 1 : 0;
+        }
+        else if (bits.simMode == 2) { // Mirror
+            row = (row < 0) ? 0 : bits.nRows - 1;
+        }
+        else {
+            Error("Bad simMode detected");
+        }
+    }
+    return &plane[row * bits.wordsPerRow];
+}
+
+static inline bitWordT CellBit(const bitWordT *row, int col) {
+    return (row[col / BitsPerWord] >> (col % BitsPerWord)) & 1;
+}
+
+/*
+ * Finds the cells a row sees just off its left (west) and right (east) edges.
+ */
+
+static void EdgeBits(bitGridT &bits, const bitWordT *row, bitWordT &west, bitWordT &east) {
+    if (bits.simMode == 1) { // Donut
+        west = CellBit(row, bits.nCols - 1);
+        east = CellBit(row, 0);
+    }
+    else if (bits.simMode == 2) { // Mirror
+        west = CellBit(row, 0);
+        east = CellBit(row, bits.nCols - 1);
+    }
+    else { // Plateau
+        west = 0;
+        east = 0;
+    }
+}
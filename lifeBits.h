@@ -0,0 +1,107 @@
+//
+//  lifeBits.h
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+/*
+ * Defines the bit-packed stepping engine.  Liveness is stored 64 cells
+ * to a word and the next generation is computed with full-adder logic,
+ * a whole word of cells at a time.
+ *
+ * Cell ages (used by DrawCellAt to fade cells, and to tell when the
+ * colony has stabilized) are bit-sliced too: bit k of every cell's age is
+ * kept in its own plane, laid out like the liveness plane.  Each step ages
+ * survivors by one, holding them at MaxAge, starts births at 1 and clears
+ * the dead, with a few bitwise operations per word of 64 cells.
+ *
+ */
+
+#ifndef life_lifeBits_h
+#define life_lifeBits_h
+
+#include <stdint.h>
+#include <vector>
+
+#include "grid.h"
+#include "lifeGrid.h"
+#include "lifeGraphics.h"
+
+typedef uint64_t bitWordT;
+
+const int BitsPerWord = 64;
+const int AgeBits = 4;          // age planes, enough to count up to MaxAge
+const long long MaxPatternCells = 1LL << 30;    // largest grid a pattern file's header may ask a loader for
+
+struct bitGridT {
+    int nRows;
+    int nCols;
+    int wordsPerRow;
+    int simMode;
+    int generation;             // generations stepped since InitBitGrid
+    int current;                // live plane holding the current generation
+    bool agesPending;           // loaded cells may still be missing their age
+    std::vector<bitWordT> live[2];
+    std::vector<bitWordT> age[AgeBits];
+};
+
+/*
+ * Packs the live cells and ages of gridLife into bits, ready to step
+ * in the given simMode (0 Plateau, 1 Donut, 2 Mirror).
+ */
+
+void InitBitGrid(bitGridT &bits, gridLifeT &gridLife, int simMode);
+
+/*
+ * Sizes bits for an empty nRows by nCols grid in the given simMode.
+ * Loaders can then bring cells to life with SetBitRun or BitRow before
+ * the first step, without building a grid of ages: every cell set this
+ * way starts at age 1 unless SetBitCellAge gives it another.
+ */
+
+void ResizeBitGrid(bitGridT &bits, int nRows, int nCols, int simMode);
+
+/*
+ * Brings the length cells of row starting at col to life.
+ */
+
+void SetBitRun(bitGridT &bits, int row, int col, int length);
+
+/*
+ * Returns the words of the given row of the current generation, for
+ * loaders to fill in directly.  Bits past the last column must stay 0.
+ */
+
+bitWordT *BitRow(bitGridT &bits, int row);
+
+/*
+ * Returns or sets the age of one cell.  A loader may set the ages of the
+ * cells it brought to life before the first step.
+ */
+
+int BitCellAge(bitGridT &bits, int row, int col);
+void SetBitCellAge(bitGridT &bits, int row, int col, int age);
+
+/*
+ * Returns the number of live cells.
+ */
+
+double BitGridPopulation(bitGridT &bits);
+
+/*
+ * Advances bits by one generation.  Returns true when every live cell
+ * has reached MaxAge, exactly as UpdateGrid does.
+ */
+
+bool StepBitGrid(bitGridT &bits);
+
+/*
+ * Copies the ages of the current generation into gridLife, which must
+ * already be sized to match.
+ */
+
+void BitGridToGrid(bitGridT &bits, gridLifeT &gridLife);
+
+#endif
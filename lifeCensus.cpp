@@ -0,0 +1,489 @@
+//
+//  lifeCensus.cpp
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+#include <algorithm>
+#include <iomanip>
+#include <utility>
+#include <vector>
+
+#include "genlib.h"
+#include "strutils.h"
+
+#include "lifeCensus.h"
+#include "lifeSparse.h"
+#include "lifeCycle.h"
+#include "lifeFile.h"
+#include "lifeThreads.h"
+
+const int CensusBatch = 64;         // soups a worker takes at a time
+const int CensusCheckEvery = 30;    // generations between looks at the population
+const int CensusMinSpan = 24;       // generations a population must repeat over at least
+const int CensusObjectGap = 2;      // cells this close belong to one object
+const int CensusPieceGap = 1;       // cells this close are never split apart
+
+typedef std::pair<int, int> cellPosT;
+
+void InitCensus(censusT &census) {
+    census.soups = 0;
+    census.unsettled = 0;
+    census.generations = 0;
+    census.objects.clear();
+}
+
+/*
+ * Fills life with soup number index of the census seeded with seed, each
+ * cell alive with even odds.
+ */
+
+static void SeedSoup(sparseLifeT &life, uint64_t seed, int64_t index, int soupSize) {
+    uint64_t state = seed ^ (uint64_t(index) * 0xD1B54A32D192ED03ULL);
+    state = NextRandom(state);
+    life.nRows = life.nCols = soupSize;
+    life.cells.clear();
+    uint64_t bits = 0;
+    int bitsLeft = 0;
+    for (int i = 0; i < soupSize; i++) {
+        for (int j = 0; j < soupSize; j++) {
+            if (bitsLeft == 0) {
+                bits = NextRandom(state);
+                bitsLeft = 64;
+            }
+            if (bits & 1) {
+                sparseCellT cell;
+                cell.row = i;
+                cell.col = j;
+                cell.age = 1;
+                life.cells.push_back(cell);
+            }
+            bits >>= 1;
+            bitsLeft--;
+        }
+    }
+}
+
+/*
+ * Returns the shortest period with which the population has repeated
+ * over the last four periods (and at least CensusMinSpan generations), or
+ * 0 if it has not.
+ */
+
+static int PopulationPeriod(std::vector<int> &pops) {
+    int g = (int) pops.size() - 1;
+    for (int p = 1; p <= CensusMaxPeriod; p++) {
+        int span = std::max(4 * p, CensusMinSpan);
+        if (g - span - p < 0) return 0;
+        bool periodic = true;
+        for (int k = 0; k < span && periodic; k++) {
+            periodic = (pops[g - k] == pops[g - k - p]);
+        }
+        if (periodic) return p;
+    }
+    return 0;
+}
+
+/*
+ * Writes the cells, turned by the given transform (bit 0 swaps rows and
+ * columns, bit 1 flips the rows, bit 2 the columns), as the body of an
+ * RLE pattern without counts.
+ */
+
+static string ShapeKey(std::vector<sparseCellT> &cells, int transform) {
+    std::vector<cellPosT> points;
+    for (size_t k = 0; k < cells.size(); k++) {
+        int row = cells[k].row, col = cells[k].col;
+        if (transform & 1) std::swap(row, col);
+        if (transform & 2) row = -row;
+        if (transform & 4) col = -col;
+        points.push_back(cellPosT(row, col));
+    }
+    std::sort(points.begin(), points.end());
+    int top = points.empty() ? 0 : points.front().first;
+    int left = 0;
+    for (size_t k = 0; k < points.size(); k++) {
+        if (k == 0 || points[k].second < left) left = points[k].second;
+    }
+    string shape;
+    int row = top, col = left;
+    for (size_t k = 0; k < points.size(); k++) {
+        for (; row < points[k].first; row++) {
+            shape += '$';
+            col = left;
+        }
+        for (; col < points[k].second; col++) {
+            shape += 'b';
+        }
+        shape += 'o';
+        col++;
+    }
+    return shape;
+}
+
+/*
+ * Runs one object on its own until the cycle watcher names it, and fills
+ * in found with its kind and the first of its shapes over every phase and
+ * orientation.  Returns false if it dies out or does not settle, which
+ * means it was not a whole object.
+ */
+
+static bool ClassifyObject(sparseLifeT &object, cycleT &cycle, censusObjectT &found) {
+    InitCycle(cycle, 0, 0);
+    std::vector<std::vector<sparseCellT> > phases;
+    phases.push_back(object.cells);
+    CycleObserveSparse(cycle, object, 0);
+    bool settled = false;
+    for (int g = 1; g <= 2 * CensusMaxPeriod + 2 && !settled; g++) {
+        StepSparseLife(object);
+        phases.push_back(object.cells);
+        settled = CycleObserveSparse(cycle, object, g);
+        if (settled && cycle.kind != DiedOut) {
+            settled = ConfirmCycle(cycle, phases[g - cycle.period], phases[g]);
+        }
+    }
+    if (!settled || cycle.kind == DiedOut) return false;
+
+    int period = (int) cycle.period;
+    for (int k = (int) phases.size() - period; k < (int) phases.size(); k++) {
+        for (int transform = 0; transform < 8; transform++) {
+            string shape = ShapeKey(phases[k], transform);
+            if (found.shape.empty() || shape < found.shape) {
+                found.shape = shape;
+                found.cells = (int) phases[k].size();
+            }
+        }
+    }
+    string periodName = "period " + IntegerToString(period);
+    switch (cycle.kind) {
+        case StillLife: found.kind = "still life"; break;
+        case Oscillator: found.kind = periodName + " oscillator"; break;
+        default: found.kind = periodName + " spaceship"; break;
+    }
+    found.count = 1;
+    return true;
+}
+
+/*
+ * Classifies each of parts, adding them to objects.  Returns false, adding
+ * none of them, if any one does not settle.
+ */
+
+static bool ClassifyParts(std::vector<sparseLifeT> parts, cycleT &cycle, std::vector<censusObjectT> &objects) {
+    size_t first = objects.size();
+    for (size_t k = 0; k < parts.size(); k++) {
+        censusObjectT found;
+        parts[k].nRows = parts[k].nCols = 0;
+        if (!ClassifyObject(parts[k], cycle, found)) {
+            objects.resize(first);
+            return false;
+        }
+        objects.push_back(found);
+    }
+    return true;
+}
+
+static int FindRoot(std::vector<int> &parent, int k) {
+    while (parent[k] != k) {
+        parent[k] = parent[parent[k]];
+        k = parent[k];
+    }
+    return k;
+}
+
+/*
+ * Joins the cells of covered (sorted, without repeats) that lie within gap
+ * of each other into groups, as a forest of parent links.
+ */
+
+static void GroupCells(std::vector<cellPosT> &covered, int gap, std::vector<int> &parent) {
+    parent.resize(covered.size());
+    for (size_t k = 0; k < covered.size(); k++) {
+        parent[k] = (int) k;
+    }
+    for (size_t k = 0; k < covered.size(); k++) {
+        // Later cells within reach of this one lie in the next few rows
+        for (size_t n = k + 1; n < covered.size() && covered[n].first <= covered[k].first + gap; n++) {
+            if (abs(covered[n].second - covered[k].second) <= gap) {
+                parent[FindRoot(parent, (int) n)] = FindRoot(parent, (int) k);
+            }
+        }
+    }
+}
+
+static bool CellBefore(const sparseCellT &a, const sparseCellT &b) {
+    return (a.row != b.row) ? a.row < b.row : a.col < b.col;
+}
+
+/*
+ * Steps cells on their own for span generations, keeping each generation,
+ * the first included, in history.
+ */
+
+static void RunAlone(std::vector<sparseCellT> &cells, int span, std::vector<std::vector<sparseCellT> > &history) {
+    sparseLifeT life;
+    life.nRows = life.nCols = 0;
+    life.cells = cells;
+    history.assign(1, cells);
+    for (int g = 0; g < span; g++) {
+        StepSparseLife(life);
+        history.push_back(life.cells);
+    }
+}
+
+/*
+ * Returns true if each generation of together is exactly the cells of the
+ * same generation of every one of apart laid over each other.
+ */
+
+static bool SameAsApart(std::vector<std::vector<sparseCellT> > &together,
+                        std::vector<std::vector<std::vector<sparseCellT> > > &apart) {
+    for (size_t g = 0; g < together.size(); g++) {
+        std::vector<sparseCellT> laid;
+        for (size_t k = 0; k < apart.size(); k++) {
+            laid.insert(laid.end(), apart[k][g].begin(), apart[k][g].end());
+        }
+        if (laid.size() != together[g].size()) return false;
+        std::sort(laid.begin(), laid.end(), CellBefore);
+        for (size_t k = 0; k < laid.size(); k++) {
+            if (laid[k].row != together[g][k].row || laid[k].col != together[g][k].col) return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Splits an object into the pieces of its current generation (cells more
+ * than CensusPieceGap apart) that evolve over span generations exactly as
+ * they would apart, such as the two blocks of a bi-block.  Pieces whose
+ * evolution changes when they are run together stay one object.  parts
+ * gets the object whole if it cannot be split.
+ */
+
+static void SplitIndependent(sparseLifeT &object, int span, std::vector<sparseLifeT> &parts) {
+    std::vector<cellPosT> positions;
+    for (size_t k = 0; k < object.cells.size(); k++) {
+        positions.push_back(cellPosT(object.cells[k].row, object.cells[k].col));
+    }
+    std::vector<int> parent;
+    GroupCells(positions, CensusPieceGap, parent);
+
+    std::map<int, int> pieceOf;
+    std::vector<std::vector<sparseCellT> > pieces;
+    for (size_t k = 0; k < object.cells.size(); k++) {
+        int root = FindRoot(parent, (int) k);
+        if (pieceOf.find(root) == pieceOf.end()) {
+            pieceOf[root] = (int) pieces.size();
+            pieces.push_back(std::vector<sparseCellT>());
+        }
+        pieces[pieceOf[root]].push_back(object.cells[k]);
+    }
+    if (pieces.size() < 2) {
+        parts.push_back(object);
+        return;
+    }
+
+    // Pieces that behave differently side by side than apart are joined
+    int nPieces = (int) pieces.size();
+    std::vector<std::vector<std::vector<sparseCellT> > > alone(nPieces);
+    for (int k = 0; k < nPieces; k++) {
+        RunAlone(pieces[k], span, alone[k]);
+    }
+    std::vector<int> joined(nPieces);
+    for (int k = 0; k < nPieces; k++) {
+        joined[k] = k;
+    }
+    for (int i = 0; i < nPieces; i++) {
+        for (int j = i + 1; j < nPieces; j++) {
+            std::vector<sparseCellT> pair(pieces[i].size() + pieces[j].size());
+            std::merge(pieces[i].begin(), pieces[i].end(), pieces[j].begin(), pieces[j].end(), pair.begin(), CellBefore);
+            std::vector<std::vector<sparseCellT> > together;
+            RunAlone(pair, span, together);
+            std::vector<std::vector<std::vector<sparseCellT> > > apart;
+            apart.push_back(alone[i]);
+            apart.push_back(alone[j]);
+            if (!SameAsApart(together, apart)) {
+                joined[FindRoot(joined, j)] = FindRoot(joined, i);
+            }
+        }
+    }
+
+    // Three pieces can meet where no two of them do, so check the split whole
+    std::map<int, int> partOf;
+    std::vector<sparseLifeT> split;
+    for (size_t k = 0; k < object.cells.size(); k++) {
+        int part = FindRoot(joined, pieceOf[FindRoot(parent, (int) k)]);
+        if (partOf.find(part) == partOf.end()) {
+            partOf[part] = (int) split.size();
+            split.push_back(sparseLifeT());
+        }
+        split[partOf[part]].cells.push_back(object.cells[k]);
+    }
+    std::vector<std::vector<sparseCellT> > whole;
+    RunAlone(object.cells, span, whole);
+    std::vector<std::vector<std::vector<sparseCellT> > > apart(split.size());
+    for (size_t k = 0; k < split.size(); k++) {
+        RunAlone(split[k].cells, span, apart[k]);
+    }
+    if (split.size() < 2 || !SameAsApart(whole, apart)) {
+        parts.push_back(object);
+        return;
+    }
+    parts.insert(parts.end(), split.begin(), split.end());
+}
+
+/*
+ * Steps a soup whose population repeats with the given period through one
+ * more period (at least four generations, so the slower phases of
+ * oscillators whose population never changes are seen too), splits the
+ * cells it covers into objects, and names each.  Returns false, leaving
+ * objects incomplete, if any object will not settle.
+ */
+
+static bool FindObjects(sparseLifeT &life, int period, std::vector<int> &pops, cycleT &cycle,
+                        std::vector<censusObjectT> &objects) {
+    std::vector<cellPosT> covered;
+    for (int g = 0; g <= std::max(period, 4); g++) {
+        if (g > 0) {
+            StepSparseLife(life);
+            pops.push_back((int) life.cells.size());
+        }
+        for (size_t k = 0; k < life.cells.size(); k++) {
+            covered.push_back(cellPosT(life.cells[k].row, life.cells[k].col));
+        }
+    }
+    std::sort(covered.begin(), covered.end());
+    covered.erase(std::unique(covered.begin(), covered.end()), covered.end());
+
+    std::vector<int> parent;
+    GroupCells(covered, CensusObjectGap, parent);
+
+    std::map<int, sparseLifeT> pieces;
+    for (size_t k = 0; k < life.cells.size(); k++) {
+        cellPosT pos(life.cells[k].row, life.cells[k].col);
+        int index = (int) (std::lower_bound(covered.begin(), covered.end(), pos) - covered.begin());
+        sparseLifeT &piece = pieces[FindRoot(parent, index)];
+        piece.cells.push_back(life.cells[k]);
+    }
+    objects.clear();
+    for (std::map<int, sparseLifeT>::iterator it = pieces.begin(); it != pieces.end(); it++) {
+        // A piece that only lasts beside the rest, like an oscillator's
+        // spark, does not settle alone; then the object is taken whole.
+        std::vector<sparseLifeT> whole(1, it->second), parts;
+        SplitIndependent(it->second, 2 * std::max(period, 4), parts);
+        if (!ClassifyParts(parts, cycle, objects)
+            && (parts.size() == 1 || !ClassifyParts(whole, cycle, objects))) return false;
+    }
+    return true;
+}
+
+static void AddObject(censusT &census, censusObjectT &found) {
+    string key = found.kind + "|" + found.shape;
+    std::map<string, censusObjectT>::iterator it = census.objects.find(key);
+    if (it == census.objects.end()) {
+        census.objects[key] = found;
+    }
+    else {
+        it->second.count += found.count;
+    }
+}
+
+/*
+ * Runs one soup until it settles and counts what it leaves.
+ */
+
+static void RunSoup(censusT &census, uint64_t seed, int64_t index, int soupSize,
+                    sparseLifeT &life, cycleT &cycle, std::vector<int> &pops) {
+    SeedSoup(life, seed, index, soupSize);
+    pops.clear();
+    pops.push_back((int) life.cells.size());
+    std::vector<censusObjectT> objects;
+    census.soups++;
+    while ((int) pops.size() <= CensusMaxGenerations) {
+        StepSparseLife(life);
+        pops.push_back((int) life.cells.size());
+        if (pops.size() % CensusCheckEvery != 0) continue;
+        int period = PopulationPeriod(pops);
+        if (period > 0 && FindObjects(life, period, pops, cycle, objects)) {
+            census.generations += pops.size() - 1;
+            for (size_t k = 0; k < objects.size(); k++) {
+                AddObject(census, objects[k]);
+            }
+            return;
+        }
+    }
+    census.generations += pops.size() - 1;
+    census.unsettled++;
+}
+
+struct censusWorkT {
+    uint64_t seed;
+    int64_t first;
+    int64_t end;
+    int soupSize;
+    int64_t next;               // the next soup not yet taken
+    std::vector<censusT> parts; // one per worker
+};
+
+static void CensusWorker(void *context, int worker, int /* nWorkers */) {
+    censusWorkT &work = *(censusWorkT *) context;
+    censusT &part = work.parts[worker];
+    sparseLifeT life;
+    cycleT cycle;
+    std::vector<int> pops;
+    while (true) {
+        int64_t start = __sync_fetch_and_add(&work.next, (int64_t) CensusBatch);
+        if (start >= work.end) break;
+        int64_t stop = std::min(start + CensusBatch, work.end);
+        for (int64_t index = start; index < stop; index++) {
+            RunSoup(part, work.seed, index, work.soupSize, life, cycle, pops);
+        }
+    }
+}
+
+void RunCensus(censusT &census, uint64_t seed, int64_t first, int64_t nSoups, int soupSize) {
+    censusWorkT work;
+    work.seed = seed;
+    work.first = first;
+    work.end = first + nSoups;
+    work.soupSize = soupSize;
+    work.next = first;
+    work.parts.resize(WorkerCount());
+    for (size_t k = 0; k < work.parts.size(); k++) {
+        InitCensus(work.parts[k]);
+    }
+    RunWorkers(CensusWorker, &work);
+
+    for (size_t k = 0; k < work.parts.size(); k++) {
+        censusT &part = work.parts[k];
+        census.soups += part.soups;
+        census.unsettled += part.unsettled;
+        census.generations += part.generations;
+        for (std::map<string, censusObjectT>::iterator it = part.objects.begin(); it != part.objects.end(); it++) {
+            AddObject(census, it->second);
+        }
+    }
+}
+
+static bool MoreCommon(const censusObjectT &a, const censusObjectT &b) {
+    if (a.count != b.count) return a.count > b.count;
+    return a.shape < b.shape;
+}
+
+void PrintCensus(ostream &out, censusT &census) {
+    std::vector<censusObjectT> objects;
+    for (std::map<string, censusObjectT>::iterator it = census.objects.begin(); it != census.objects.end(); it++) {
+        objects.push_back(it->second);
+    }
+    std::sort(objects.begin(), objects.end(), MoreCommon);
+    out << "# " << census.soups << " soups, " << census.unsettled << " unsettled, "
+        << census.generations << " generations" << endl;
+    out << setw(12) << "count" << "  " << left << setw(24) << "object" << right
+        << setw(6) << "cells" << "  shape" << endl;
+    for (size_t k = 0; k < objects.size(); k++) {
+        out << setw(12) << objects[k].count << "  " << left << setw(24) << objects[k].kind << right
+            << setw(6) << objects[k].cells << "  " << objects[k].shape << endl;
+    }
+}
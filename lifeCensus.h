@@ -0,0 +1,80 @@
+//
+//  lifeCensus.h
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+/*
+ * Runs a census of random soups: many small random patterns, each run on
+ * the unbounded plane until it settles, with what is left of each counted
+ * object by object.
+ *
+ * Soup k of a census seeded with s is always the same soup, whatever the
+ * number of threads, so any soup in the table can be found again.  A soup
+ * has settled once its population has repeated with some period for
+ * several periods running.  Its cells, taken over one period, are then
+ * split into objects (cells within two of each other belong together).
+ * An object whose pieces run exactly as they would apart, such as a
+ * bi-block or two blinkers, is split into those pieces.  Each object is
+ * run on its own until the cycle watcher names it.  A
+ * soup with an object that does not settle alone is run on and looked at
+ * again; one that has not settled after CensusMaxGenerations is counted
+ * as unsettled.
+ *
+ * Soups are shared out among the worker threads a batch at a time.
+ *
+ */
+
+#ifndef life_lifeCensus_h
+#define life_lifeCensus_h
+
+#include <stdint.h>
+#include <iostream>
+#include <map>
+
+#include "genlib.h"
+
+const int CensusSoupSize = 16;          // soups are this many cells square
+const int CensusMaxGenerations = 20000;
+const int CensusMaxPeriod = 60;         // longest population period looked for
+
+/*
+ * Type: censusObjectT
+ * -------------------
+ * One kind of object found, by its shape in the phase and orientation
+ * that writes it first, as the body of an RLE pattern without counts.
+ */
+
+struct censusObjectT {
+    string kind;            // "still life", "period 2 oscillator", ...
+    int cells;              // live cells in the phase shown
+    string shape;
+    int64_t count;
+};
+
+struct censusT {
+    int64_t soups;
+    int64_t unsettled;      // soups still changing after CensusMaxGenerations
+    int64_t generations;    // generations stepped over all soups
+    std::map<string, censusObjectT> objects;
+};
+
+void InitCensus(censusT &census);
+
+/*
+ * Runs soups first to first + nSoups - 1 of the census seeded with seed,
+ * each soupSize cells square, on all the worker threads, adding what they
+ * settle into to census.
+ */
+
+void RunCensus(censusT &census, uint64_t seed, int64_t first, int64_t nSoups, int soupSize = CensusSoupSize);
+
+/*
+ * Prints the census as a table, most common objects first.
+ */
+
+void PrintCensus(ostream &out, censusT &census);
+
+#endif
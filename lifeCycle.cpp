@@ -0,0 +1,282 @@
+//
+//  lifeCycle.cpp
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+#include "genlib.h"
+#include "strutils.h"
+
+#include "lifeCycle.h"
+
+const uint64_t RowMultiplier = 0x9E3779B97F4A7C15ULL;
+const uint64_t ColMultiplier = 0xC2B2AE3D27D4EB4FULL;
+const uint64_t PopulationMix = 0x165667B19E3779F9ULL;
+
+/*
+ * Returns the inverse of the odd number a modulo 2^64.  Each round of
+ * Newton's iteration doubles the number of correct low bits, and a is its
+ * own inverse to three bits.
+ */
+
+static uint64_t Inverse(uint64_t a) {
+    uint64_t x = a;
+    for (int k = 0; k < 5; k++) {
+        x *= 2 - a * x;
+    }
+    return x;
+}
+
+/*
+ * Extends the tables of powers and inverse powers of multiplier to n entries.
+ */
+
+static void GrowPowers(std::vector<uint64_t> &power, std::vector<uint64_t> &inverse, uint64_t multiplier, size_t n) {
+    if (power.empty()) {
+        power.push_back(1);
+        inverse.push_back(1);
+    }
+    uint64_t step = Inverse(multiplier);
+    while (power.size() < n) {
+        power.push_back(power.back() * multiplier);
+        inverse.push_back(inverse.back() * step);
+    }
+}
+
+void InitCycle(cycleT &cycle, int nRows, int nCols) {
+    cycle.nRows = nRows;
+    cycle.nCols = nCols;
+    cycle.hash = 0;
+    cycle.population = 0;
+    cycle.rowCount.assign(nRows, 0);
+    cycle.colCount.assign(nCols, 0);
+    GrowPowers(cycle.rowPower, cycle.rowInverse, RowMultiplier, nRows);
+    GrowPowers(cycle.colPower, cycle.colInverse, ColMultiplier, nCols);
+    cycleSeenT unused = { 0, 0, 0, -1 };
+    cycle.recent.assign(CycleWindow, unused);
+    cycle.seen.clear();
+    cycle.period = 0;
+    cycle.shiftRows = cycle.shiftCols = 0;
+    cycle.confirmed = 0;
+    cycle.kind = NoCycle;
+}
+
+void CycleToggle(cycleT &cycle, int row, int col, bool born) {
+    uint64_t term = cycle.rowPower[row] * cycle.colPower[col];
+    int change = born ? 1 : -1;
+    cycle.hash += born ? term : -term;
+    cycle.population += change;
+    cycle.rowCount[row] += change;
+    cycle.colCount[col] += change;
+}
+
+/*
+ * Names the repeat the watch has found.
+ */
+
+static void NameCycle(cycleT &cycle) {
+    if (cycle.shiftRows != 0 || cycle.shiftCols != 0) {
+        cycle.kind = Spaceship;
+    }
+    else {
+        cycle.kind = (cycle.period == 1) ? StillLife : Oscillator;
+    }
+}
+
+/*
+ * Compares the generation just hashed with the ones before it.  The
+ * latest match, P generations back, gives the shortest period, and the
+ * colony counts as cycling from the first one.
+ */
+
+static bool Detect(cycleT &cycle, int64_t generation, uint64_t hash, int64_t top, int64_t left) {
+    if (cycle.population == 0) {
+        cycle.kind = DiedOut;
+        return true;
+    }
+    uint64_t key = hash ^ (uint64_t(cycle.population) * PopulationMix);
+    std::map<uint64_t, int64_t>::iterator found = cycle.seen.find(key);
+    if (found != cycle.seen.end() && generation - found->second <= CycleWindow) {
+        cycleSeenT &then = cycle.recent[found->second % CycleWindow];
+        int64_t period = generation - found->second;
+        int64_t shiftRows = top - then.top;
+        int64_t shiftCols = left - then.left;
+        if (period == cycle.period && shiftRows == cycle.shiftRows && shiftCols == cycle.shiftCols) {
+            cycle.confirmed++;
+        }
+        else {
+            cycle.period = period;
+            cycle.shiftRows = shiftRows;
+            cycle.shiftCols = shiftCols;
+            cycle.confirmed = 1;
+        }
+    }
+    else {
+        cycle.confirmed = 0;
+    }
+
+    cycleSeenT &slot = cycle.recent[generation % CycleWindow];
+    if (slot.generation >= 0) {
+        std::map<uint64_t, int64_t>::iterator old = cycle.seen.find(slot.key);
+        if (old != cycle.seen.end() && old->second == slot.generation) {
+            cycle.seen.erase(old);
+        }
+    }
+    slot.key = key;
+    slot.top = top;
+    slot.left = left;
+    slot.generation = generation;
+    cycle.seen[key] = generation;
+
+    if (cycle.confirmed == 0) {
+        return false;
+    }
+    NameCycle(cycle);
+    return true;
+}
+
+bool CycleObserve(cycleT &cycle, int64_t generation) {
+    int top = 0, left = 0;
+    if (cycle.population > 0) {
+        while (cycle.rowCount[top] == 0) top++;
+        while (cycle.colCount[left] == 0) left++;
+    }
+    uint64_t hash = cycle.hash * cycle.rowInverse[top] * cycle.colInverse[left];
+    return Detect(cycle, generation, hash, top, left);
+}
+
+bool CycleObserveSparse(cycleT &cycle, sparseLifeT &life, int64_t generation) {
+    int top = 0, left = 0, bottom = -1, right = -1;
+    SparseLifeBounds(life, top, left, bottom, right);
+    GrowPowers(cycle.rowPower, cycle.rowInverse, RowMultiplier, bottom - top + 1);
+    GrowPowers(cycle.colPower, cycle.colInverse, ColMultiplier, right - left + 1);
+    uint64_t hash = 0;
+    for (size_t k = 0; k < life.cells.size(); k++) {
+        hash += cycle.rowPower[life.cells[k].row - top] * cycle.colPower[life.cells[k].col - left];
+    }
+    cycle.population = life.cells.size();
+    return Detect(cycle, generation, hash, top, left);
+}
+
+/*
+ * The words are the period, shift and count of the repeat being confirmed,
+ * then the key, top, left and generation of each remembered generation.
+ */
+
+const int WatchHeader = 4;
+const int WatchEntry = 4;
+
+void SaveCycleWatch(cycleT &cycle, std::vector<uint64_t> &words) {
+    words.clear();
+    words.push_back(cycle.period);
+    words.push_back(cycle.shiftRows);
+    words.push_back(cycle.shiftCols);
+    words.push_back(cycle.confirmed);
+    for (size_t k = 0; k < cycle.recent.size(); k++) {
+        cycleSeenT &slot = cycle.recent[k];
+        if (slot.generation < 0) continue;
+        words.push_back(slot.key);
+        words.push_back(slot.top);
+        words.push_back(slot.left);
+        words.push_back(slot.generation);
+    }
+}
+
+/*
+ * Whatever the watch recorded while it was being set up is dropped first.
+ * seen holds the latest generation of each key still in recent, which is
+ * what Detect leaves it holding.  A run saved as it stopped comes back
+ * with its verdict.
+ */
+
+bool RestoreCycleWatch(cycleT &cycle, std::vector<uint64_t> &words, int64_t generation) {
+    if (words.size() < WatchHeader || (words.size() - WatchHeader) % WatchEntry != 0
+        || (words.size() - WatchHeader) / WatchEntry > CycleWindow) return false;
+    cycleSeenT unused = { 0, 0, 0, -1 };
+    cycle.recent.assign(CycleWindow, unused);
+    cycle.seen.clear();
+    cycle.kind = NoCycle;
+    cycle.period = (int64_t) words[0];
+    cycle.shiftRows = (int64_t) words[1];
+    cycle.shiftCols = (int64_t) words[2];
+    cycle.confirmed = (int64_t) words[3];
+    if (cycle.period < 0 || cycle.period > CycleWindow || cycle.confirmed < 0) return false;
+    for (size_t k = WatchHeader; k < words.size(); k += WatchEntry) {
+        int64_t then = (int64_t) words[k + 3];
+        if (then < 0 || then > generation || generation - then >= CycleWindow) return false;
+        cycleSeenT &slot = cycle.recent[then % CycleWindow];
+        if (slot.generation >= 0) return false;
+        slot.key = words[k];
+        slot.top = (int64_t) words[k + 1];
+        slot.left = (int64_t) words[k + 2];
+        slot.generation = then;
+        std::map<uint64_t, int64_t>::iterator found = cycle.seen.find(slot.key);
+        if (found == cycle.seen.end() || found->second < then) {
+            cycle.seen[slot.key] = then;
+        }
+    }
+    if (cycle.population == 0) {
+        cycle.kind = DiedOut;
+    }
+    else if (cycle.confirmed > 0) {
+        NameCycle(cycle);
+    }
+    return true;
+}
+
+static int LeftColumn(std::vector<sparseCellT> &cells) {
+    int left = cells[0].col;
+    for (size_t k = 1; k < cells.size(); k++) {
+        if (cells[k].col < left) left = cells[k].col;
+    }
+    return left;
+}
+
+bool ConfirmCycle(cycleT &cycle, std::vector<sparseCellT> &before, std::vector<sparseCellT> &after) {
+    if (cycle.kind == DiedOut) return true;
+    bool same = !before.empty() && before.size() == after.size();
+    if (same) {
+        int rows = after[0].row - before[0].row;
+        int cols = LeftColumn(after) - LeftColumn(before);
+        same = (rows == cycle.shiftRows && cols == cycle.shiftCols);
+        for (size_t k = 0; k < before.size() && same; k++) {
+            same = (after[k].row - before[k].row == rows && after[k].col - before[k].col == cols);
+        }
+    }
+    if (!same) {
+        cycle.kind = NoCycle;
+        cycle.confirmed = 0;
+    }
+    return same;
+}
+
+static string Steps(int64_t n, string unit, string negative, string positive) {
+    int64_t count = (n < 0) ? -n : n;
+    return IntegerToString((int) count) + " " + unit + ((count == 1) ? " " : "s ") + ((n < 0) ? negative : positive);
+}
+
+string CycleVerdict(cycleT &cycle) {
+    string period = "period " + IntegerToString((int) cycle.period);
+    switch (cycle.kind) {
+        case DiedOut:
+            return "died out";
+        case StillLife:
+            return "still life";
+        case Oscillator:
+            return period + " oscillator";
+        case Spaceship: {
+            string moving;
+            if (cycle.shiftRows != 0) {
+                moving = Steps(cycle.shiftRows, "row", "up", "down");
+            }
+            if (cycle.shiftCols != 0) {
+                moving += (moving.empty() ? "" : " and ") + Steps(cycle.shiftCols, "column", "left", "right");
+            }
+            return period + " spaceship moving " + moving;
+        }
+        default:
+            return "no cycle found";
+    }
+}
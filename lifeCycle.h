@@ -0,0 +1,141 @@
+//
+//  lifeCycle.h
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+/*
+ * Watches a run for the colony repeating itself, so it can be stopped as
+ * soon as it settles into a still life, an oscillator or a spaceship.
+ *
+ * Every generation gets a 64-bit hash of its live cells, the sum over them
+ * of A^row * B^col for two fixed odd multipliers A and B.  A cell being
+ * born or dying adds or removes its one term, so the hash is kept up to
+ * date by visiting only the cells that changed.  Moving the colony by
+ * (dr, dc) multiplies the sum by A^dr * B^dc, so multiplying by the
+ * inverse powers for the top and left of its bounding box gives a hash
+ * that is the same wherever the colony sits.
+ *
+ * The last CycleWindow hashes are kept, and a generation whose hash was
+ * seen P generations before is the colony repeating with period P, moved
+ * as far as its bounding box moved.  The rules are deterministic, so one
+ * repeat is enough.  Ages play no part: they are how the colony is drawn,
+ * not what it is.  Two colonies can share a hash, so a repeat is only
+ * believed once ConfirmCycle has compared the cells themselves.
+ *
+ */
+
+#ifndef life_lifeCycle_h
+#define life_lifeCycle_h
+
+#include <stdint.h>
+#include <map>
+#include <vector>
+
+#include "genlib.h"
+#include "lifeSparse.h"
+
+/*
+ * Longest period looked for.
+ */
+
+const int CycleWindow = 4096;
+
+enum cycleKindT {
+    NoCycle,
+    DiedOut,
+    StillLife,
+    Oscillator,
+    Spaceship
+};
+
+struct cycleSeenT {
+    uint64_t key;
+    int64_t top;
+    int64_t left;
+    int64_t generation;     // -1 while the slot is unused
+};
+
+struct cycleT {
+    int nRows;
+    int nCols;
+    uint64_t hash;                      // sum of A^row * B^col over the live cells
+    int64_t population;
+    std::vector<int> rowCount;          // live cells in each row
+    std::vector<int> colCount;          // live cells in each column
+    std::vector<uint64_t> rowPower;     // A^row
+    std::vector<uint64_t> colPower;     // B^col
+    std::vector<uint64_t> rowInverse;   // A^-row
+    std::vector<uint64_t> colInverse;   // B^-col
+    std::vector<cycleSeenT> recent;     // generation g kept at g % CycleWindow
+    std::map<uint64_t, int64_t> seen;   // the last generation each key was seen
+    int64_t period;                     // the repeat being confirmed
+    int64_t shiftRows;
+    int64_t shiftCols;
+    int64_t confirmed;                  // generations in a row that repeated it
+    cycleKindT kind;
+};
+
+/*
+ * Sets up cycle for a bounded grid of the given size with no live cells.
+ * Cells are then added with CycleToggle.
+ */
+
+void InitCycle(cycleT &cycle, int nRows, int nCols);
+
+/*
+ * Records the cell at row, col being born (born true) or dying.
+ */
+
+void CycleToggle(cycleT &cycle, int row, int col, bool born);
+
+/*
+ * Looks for a repeat, after the cells that changed in generation have
+ * been toggled.  Returns true once the colony has died out or repeats an
+ * earlier generation.
+ */
+
+bool CycleObserve(cycleT &cycle, int64_t generation);
+
+/*
+ * Like CycleObserve, for the live-cell engine, whose plane is unbounded.
+ * The hash is worked out afresh from the cell list, which costs no more
+ * than the step that built it.
+ */
+
+bool CycleObserveSparse(cycleT &cycle, sparseLifeT &life, int64_t generation);
+
+/*
+ * Checks a repeat that CycleObserve or CycleObserveSparse reported against
+ * the cells: before holds the live cells of one generation and after those
+ * of cycle.period generations later, each sorted by row then column.  They
+ * must be the same shape, moved by the repeat's shift.  If not, the repeat
+ * was a hash collision: it is forgotten and false is returned.
+ */
+
+bool ConfirmCycle(cycleT &cycle, std::vector<sparseCellT> &before, std::vector<sparseCellT> &after);
+
+/*
+ * Saves the part of the watch the live cells cannot give back (the recent
+ * hashes and the repeat being confirmed) as a list of words, and restores
+ * it into a cycle just set up around the same cells at the given
+ * generation, so a resumed run stops where the original would have.  A
+ * watch saved as its run stopped is restored with the kind of cycle it
+ * found.  Restoring returns false if the words do not describe such a
+ * watch.
+ */
+
+void SaveCycleWatch(cycleT &cycle, std::vector<uint64_t> &words);
+bool RestoreCycleWatch(cycleT &cycle, std::vector<uint64_t> &words, int64_t generation);
+
+/*
+ * Describes what the colony settled into: "still life", "period 2
+ * oscillator", "period 4 spaceship moving 1 row down and 1 column right"
+ * or "died out".
+ */
+
+string CycleVerdict(cycleT &cycle);
+
+#endif
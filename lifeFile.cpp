@@ -0,0 +1,173 @@
+//
+//  lifeFile.cpp
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+#include <ctime>
+#include <unistd.h>
+
+#include "genlib.h"
+#include "strutils.h"
+#include "grid.h"
+
+#include "lifeFile.h"
+#include "lifeRle.h"
+#include "lifeSnapshot.h"
+#include "lifeTrace.h"
+
+gridLifeT GetGridFromFile(ifstream &in1) {
+    gridLifeT gridLife;
+    gridLifeT theGrid;
+    gridSizeT gridSize;
+    gridSize.row = gridSize.col = 0;
+    bool gotRow = false;
+    int currentRow = 0;
+    
+    //cout << "Got a good file name" << endl;
+    
+    while (true) {
+        string line;
+        getline(in1,line);
+        if (in1.fail()) {
+            break;
+        }
+        if (line[0] == 'X' || line[0] == '-')  { // Parse for Grid
+            GetOneRow(line, theGrid, currentRow);
+            currentRow += 1;
+        }
+        else if (line[0] == '#') { // Ignore comments
+            
+        }
+        else { // Assume well-formed file (no error checking)
+            int param = StringToInteger(line);
+            if (gotRow) {
+                gridSize.col = param;
+                theGrid.resize(gridSize.row, gridSize.col);
+            }
+            else {
+                gridSize.row = param;
+                gotRow = true;
+            }
+        }
+    }
+    
+    gridLife = theGrid;
+    return gridLife;
+}
+
+template <typename CellT>
+void GetOneRow(string line, Grid<CellT> &theGrid, int currentRow) {
+    int numCols = theGrid.numCols();
+    
+    for (int i = 0; i < numCols; i++) {
+        int age = 0;
+        if (line[i] == 'X') {
+            age = 1;
+        }
+        theGrid[currentRow][i] = age;
+    }
+}
+
+bool IsRleFile(string filename) {
+    return filename.size() > 4 && ConvertToLowerCase(filename.substr(filename.size() - 4)) == ".rle";
+}
+
+bool ReadGridFile(string filename, gridLifeT &gridLife) {
+    TRACE_SCOPE(LoadPhase);
+    ifstream in1;
+    in1.open(filename.c_str());
+    if (in1.fail()) {
+        return false;
+    }
+    if (IsSnapshotFile(filename)) {
+        in1.close();
+        if (!LoadSnapshotGrid(filename, gridLife)) {
+            Error("Unreadable snapshot " + filename);
+        }
+        return true;
+    }
+    if (IsRleFile(filename)) {
+        if (!ReadRleGrid(in1, gridLife)) {
+            Error("Malformed RLE pattern in " + filename);
+        }
+    }
+    else {
+        gridLife = GetGridFromFile(in1);
+    }
+    in1.close();
+    return true;
+}
+
+static uint64_t randomState = 0;
+static bool randomSeeded = false;
+
+void SeedGridRandom(uint64_t seed) {
+    randomState = seed;
+    randomSeeded = true;
+}
+
+uint64_t GridRandomState() {
+    return randomState;
+}
+
+void SetGridRandomState(uint64_t state) {
+    SeedGridRandom(state);
+}
+
+uint64_t NextRandom(uint64_t &state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static int GridRandomInteger(int low, int high) {
+    if (!randomSeeded) {
+        SeedGridRandom((uint64_t) time(NULL) * 0x9E3779B97F4A7C15ULL ^ getpid());
+    }
+    return low + (int) (NextRandom(randomState) % (uint64_t) (high - low + 1));
+}
+
+gridLifeT GenerateRandomGrid(int nRows, int nCols) {
+    gridLifeT gridLife;
+    
+    //cout << "Random Grid Generation." << endl;
+    
+    gridLife.resize(nRows, nCols);
+    FillRandomGrid(gridLife);
+    return gridLife;
+}
+
+template <typename CellT>
+void FillRandomGrid(Grid<CellT> &gridLife) {
+    for (int i = 0; i < gridLife.numRows(); i++) {
+        for (int j = 0; j < gridLife.numCols(); j++) {
+            gridLife[i][j] = GridRandomInteger(0, 1);
+            if (gridLife[i][j] > 0) {
+                gridLife[i][j] = GridRandomInteger(1, 12);
+            }
+        }
+    }
+}
+
+template void GetOneRow(string line, Grid<int> &theGrid, int currentRow);
+template void GetOneRow(string line, Grid<cellT> &theGrid, int currentRow);
+template void FillRandomGrid(Grid<int> &gridLife);
+template void FillRandomGrid(Grid<cellT> &gridLife);
+
+void WriteGrid(ostream &out, gridLifeT &gridLife) {
+    out << gridLife.numRows() << endl;
+    out << gridLife.numCols() << endl;
+    for (int i = 0; i < gridLife.numRows(); i++) {
+        string line(gridLife.numCols(), '-');
+        for (int j = 0; j < gridLife.numCols(); j++) {
+            if (gridLife[i][j] > 0) {
+                line[j] = 'X';
+            }
+        }
+        out << line << endl;
+    }
+}
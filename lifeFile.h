@@ -0,0 +1,100 @@
+//
+//  lifeFile.h
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+/*
+ * Defines how starting grids are read from pattern files or seeded
+ * randomly, and how a grid is written back out.  Both the graphical
+ * game and the batch runner start their colonies here.
+ *
+ * A pattern file holds the number of rows and the number of columns,
+ * one per line, followed by one line per row of 'X' (alive) and '-'
+ * (dead).  Lines starting with '#' are comments.  Files named *.rle are
+ * read with the RLE reader in lifeRle instead.
+ *
+ */
+
+#ifndef life_lifeFile_h
+#define life_lifeFile_h
+
+#include <stdint.h>
+#include <iostream>
+#include <fstream>
+
+#include "genlib.h"
+#include "grid.h"
+#include "lifeGrid.h"
+
+const int RandomRows = 70;  // size of a randomly seeded grid
+const int RandomCols = 90;
+
+/*
+ * Reads a grid from an open pattern file.  Live cells start at age 1.
+ */
+
+gridLifeT GetGridFromFile(ifstream &in1);
+
+/*
+ * Fills one row of theGrid from a line of a pattern file.
+ */
+
+template <typename CellT>
+void GetOneRow(string line, Grid<CellT> &theGrid, int currentRow);
+
+/*
+ * Returns true if filename names an RLE pattern (by its .rle extension).
+ */
+
+bool IsRleFile(string filename);
+
+/*
+ * Opens and reads the named pattern file into gridLife, as RLE if the
+ * name ends in .rle, or as the window of a snapshot if it ends in
+ * .lifesnap.  Returns false if the file cannot be opened.
+ */
+
+bool ReadGridFile(string filename, gridLifeT &gridLife);
+
+/*
+ * Seeds a grid of the given size with live cells of random ages.
+ */
+
+gridLifeT GenerateRandomGrid(int nRows = RandomRows, int nCols = RandomCols);
+
+/*
+ * Seeds every cell of an already sized grid the same way.
+ */
+
+template <typename CellT>
+void FillRandomGrid(Grid<CellT> &gridLife);
+
+/*
+ * Random grids come from a small generator of their own (splitmix64)
+ * rather than the cs106 one, so that its whole state is a single number
+ * a snapshot can save and restore.  Unless seeded, it seeds itself from
+ * the clock on first use.
+ */
+
+void SeedGridRandom(uint64_t seed);
+uint64_t GridRandomState();
+void SetGridRandomState(uint64_t state);
+
+/*
+ * Advances a splitmix64 state and returns its next 64 random bits, for
+ * callers that need a generator of their own (one per thread, say).
+ */
+
+uint64_t NextRandom(uint64_t &state);
+
+/*
+ * Writes gridLife to out as a pattern file that GetGridFromFile can read
+ * back.  Ages are not kept.
+ */
+
+void WriteGrid(ostream &out, gridLifeT &gridLife);
+
+#endif
@@ -1 +1 @@
-/* * File: lifeGraphics.h * Modified Fri Sep 29 12:30:59 PDT 2006 jzelenski * ----------------------------------------------- * Defines simple drawing routines for a 2-d grid of circles, * designed for use in the Life assignment. */#ifndef _lifegraphics_h#define _lifegraphics_h/* * Constant: MaxAge * ---------------- * We only have a fixed number of density levels to show * the progression of age. At age 1, a cell is a solid dot, * and each subsequent age is fainter. At age MaxAge and beyond,  * the same very faint pattern is used. */const int MaxAge = 12;/* * Function: InitLifeGraphics * Usage: InitLifeGraphics(10, 25); * -------------------------------- * This will erase the graphics window completely and draw a black * border around the simulation rectangle which is centered in the * window.  The grid cells will be sized as large as will fit given * the grid geometry. Grids with more rows and columns will use smaller  * cells and vice versa. This function can be used at the beginning of  * a simulation or between generations to clear the window before drawing  * the next generation. */void InitLifeGraphics(int numRows, int numCols);/* * Function: DrawCellAt * Usage: DrawCellAt(5, 0, 2); * --------------------------- * Draws the cell at the specific row and col, replacing any previous * cell at that location.  The grid geometry must have earlier been  * configured with the InitLifeGraphics function above. Rows and columns  * are specified using zero-based indexing and (0,0) is the upper-left corner.   * If the location given is not in bounds, an error is raised. * At startup, a random color is chosen for the simulation.  Each cell  * will be displayed in a shade which tells its age.  Cells that have just  * been born (i.e. that have value 1) are the darkest, they get lighter with  * age as the values go to 2, 3, and so on.  The cells stabilize as very faint  * at generation MaxAge and older.  Passing 0 for age means the cell is not alive, * the cell is drawn in white, erasing any previous contents. */void DrawCellAt(int row, int col, int age);#endif 
\ No newline at end of file
+/* * File: lifeGraphics.h * Modified Fri Sep 29 12:30:59 PDT 2006 jzelenski * ----------------------------------------------- * Defines simple drawing routines for a 2-d grid of circles, * designed for use in the Life assignment. */#ifndef _lifegraphics_h#define _lifegraphics_h#include <vector>#include "genlib.h"#include "grid.h"/* * Constant: MaxAge * ---------------- * We only have a fixed number of density levels to show * the progression of age. At age 1, a cell is a solid dot, * and each subsequent age is fainter. At age MaxAge and beyond,  * the same very faint pattern is used. */const int MaxAge = 12;/* * Function: InitLifeGraphics * Usage: InitLifeGraphics(10, 25); * -------------------------------- * This will erase the graphics window completely and draw a black * border around the simulation rectangle which is centered in the * window.  The grid cells will be sized as large as will fit given * the grid geometry. Grids with more rows and columns will use smaller  * cells and vice versa. This function can be used at the beginning of  * a simulation or between generations to clear the window before drawing  * the next generation. */void InitLifeGraphics(int numRows, int numCols);/* * Function: DrawCellAt * Usage: DrawCellAt(5, 0, 2); * --------------------------- * Draws the cell at the specific row and col, replacing any previous * cell at that location.  The grid geometry must have earlier been  * configured with the InitLifeGraphics function above. Rows and columns  * are specified using zero-based indexing and (0,0) is the upper-left corner.   * If the location given is not in bounds, an error is raised. * At startup, a random color is chosen for the simulation.  Each cell  * will be displayed in a shade which tells its age.  Cells that have just  * been born (i.e. that have value 1) are the darkest, they get lighter with  * age as the values go to 2, 3, and so on.  The cells stabilize as very faint  * at generation MaxAge and older.  Passing 0 for age means the cell is not alive, * the cell is drawn in white, erasing any previous contents. */void DrawCellAt(int row, int col, int age);/* * Function: UpdateCellAt * Usage: UpdateCellAt(5, 0, 2); * ----------------------------- * Like DrawCellAt, but remembers the shade last drawn at every location * since InitLifeGraphics and does nothing when the shade would not change. * Shades are drawn fully dense, pre-blended with white, so a new shade * replaces the old one in a single call.  Redrawing a generation this way * costs draw calls only for the cells that were born, died or aged. */void UpdateCellAt(int row, int col, int age);/* * Type: frameBufferT * ------------------ * An offscreen picture of the whole grid, four bytes (red, green, blue, * alpha) per pixel with the top row first.  Each cell is a square of * scale by scale pixels, colored from a table holding the same shades * DrawCellAt uses, already blended with white.  Filling the buffer costs * a few stores per pixel, and the finished frame is saved in one write, * for headless runs; the graphics window is drawn with UpdateCellAt. */struct frameBufferT {	int numRows, numCols;	int scale;							// pixels per cell along each side	int width, height;					// in pixels	std::vector<unsigned char> pixels;	unsigned char palette[MaxAge + 1][4];	// RGBA for each age; age 0 is white};/* * Function: InitFrameBuffer * Usage: InitFrameBuffer(frame, 10, 25, 4); * ----------------------------------------- * Sizes frame for a grid of the given geometry and fills its color * table.  A scale of 0 picks the largest cells that fit the graphics * window, as InitLifeGraphics does. */void InitFrameBuffer(frameBufferT &frame, int numRows, int numCols, int scale);/* * Function: RenderFrame * Usage: RenderFrame(frame, grid); * -------------------------------- * Paints every cell of grid, a grid of ages, into the frame's pixels. * The ages may be stored as int or as unsigned char. */template <typename CellType>void RenderFrame(frameBufferT &frame, Grid<CellType> &grid);/* * Function: WriteFrameBMP * Usage: if (!WriteFrameBMP(frame, "life.bmp")) ... * ------------------------------------------------- * Saves the frame as a 32-bit .bmp file, for headless runs.  Returns * false if the file cannot be written. */bool WriteFrameBMP(frameBufferT &frame, string filename);#endif 
\ No newline at end of file
@@ -8,6 +8,11 @@
 
 
 #include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <pthread.h>
 
 #include "genlib.h"
 #include "extgraph.h"
@@ -17,6 +22,13 @@
 
 #include "lifeGrid.h"
 #include "lifeGraphics.h"
+#include "lifeSim.h"
+#include "lifeThreads.h"
+#include "lifeSnapshot.h"
+#include "lifeHistory.h"
+#include "lifeTrace.h"
+#include "lifeLatency.h"
+#include "lifePerf.h"
 
 /*
  * Simulation Update Speed Note:
@@ -27,11 +39,16 @@
 const double FrameRateMuliplier = 0.1; // Fast Simulation
 //Nullifies the fast sim when turtle mode (3 - 1 = 2) selected. 2 * 0.25 = 0.5 second updates.
 const double FrameRateAdjustment = (1 / FrameRateMuliplier) * 0.25;
+const double RefreshInterval = 1.0 / 60; // Ludicrous Speed draws at most this often
+const int64_t CheckpointEvery = 10000;   // generations between automatic checkpoints
+const string CheckpointFile = "life.lifesnap";
+const size_t HistoryBudget = 64 << 20;  // bytes of generations kept for stepping back
+const double LatencyReportEvery = 5;    // seconds between live reports of the frame times
+const double SeekProgressEvery = 0.25;  // seconds between progress frames while "g N" steps forward
+const char *PerfVariable = "LIFE_PERF"; // if set, count hardware events while stepping and drawing
 
 void ShowGrid(gridLifeT &gridLife);
-bool IsDirectionOccupied(gridLifeT &gridLife, int row, int col, int simMode,int dRow, int dCol, int nRows, int nCols);
-int CheckForNeighbors(gridLifeT &gridLife, int row, int col, int simMode, int nRows, int nCols);
-bool UpdateGrid(gridLifeT &gridLife, int simMode);
+static inline cellT *PlaneRow(lifeStateT &state, std::vector<cellT> &plane, int row);
 
 void DrawGridX(gridLifeT &gridLife) {
     int rows = gridLife.numRows();
@@ -58,56 +75,334 @@ void DrawGrid1(gridLifeT &gridLife) {
         }
 }
 
-void DrawGrid(gridLifeT &gridLife) {
+template <typename CellT>
+void DrawGrid(Grid<CellT> &gridLife) {
+    TRACE_SCOPE(DrawPhase);
     int rows = gridLife.numRows();
     int cols = gridLife.numCols();
-    InitGraphics(); // Flushes the graphics palette
     for (int i = 0; i < rows; i++)
         for (int j = 0; j < cols; j++) {
-            if (gridLife[i][j] != 0) {  
-                // DrawCellAt is an expensive operation, CPU-wise.
-                // Only use for cells with life, not empty cells.
-                DrawCellAt(i, j, gridLife[i][j]);
+            // DrawCellAt is an expensive operation, CPU-wise.
+            // UpdateCellAt only calls it for cells whose shade changed.
+            UpdateCellAt(i, j, gridLife[i][j]);
+        }
+}
+
+template void DrawGrid(Grid<int> &gridLife);
+template void DrawGrid(Grid<cellT> &gridLife);
+
+/*
+ * Draws the newest generation of sim over the one drawn before it.
+ * The standard engine knows which tiles changed in its last step, so only
+ * those cells are looked at; the other engines export the whole grid and
+ * leave the comparing to UpdateCellAt.  Must be called after every step.
+ */
+
+static void DrawSimGrid(lifeSimT &sim) {
+    if (sim.engine != DenseEngine) {
+        DrawGrid(SimGrid(sim));
+        return;
+    }
+    TRACE_SCOPE(DrawPhase);
+    lifeStateT &state = sim.dense;
+    for (int tr = 0; tr < state.nTileRows; tr++) {
+        for (int tc = 0; tc < state.nTileCols; tc++) {
+            if (!state.tileChanged[tr * state.nTileCols + tc]) continue;
+            int lastRow = std::min((tr + 1) * TileRows, state.nRows);
+            int lastCol = std::min((tc + 1) * TileCols, state.nCols);
+            for (int i = tr * TileRows; i < lastRow; i++) {
+                const cellT *row = PlaneRow(state, state.buffer[state.current], i);
+                for (int j = tc * TileCols; j < lastCol; j++) {
+                    UpdateCellAt(i, j, row[j]);
+                }
             }
         }
+    }
+}
+
+/*
+ * The mouse poll, the pause between generations and the console read,
+ * wrapped so each shows up as a phase of its own in a trace.
+ */
+
+static bool MouseClicked() {
+    TRACE_SCOPE(InputPhase);
+    return MouseButtonIsDown();
+}
+
+static void PauseFor(double seconds) {
+    TRACE_SCOPE(PausePhase);
+    Pause(seconds);
+}
+
+static string ReadCommand() {
+    TRACE_SCOPE(InputPhase);
+    return ConvertToLowerCase(GetLine());
+}
+
+/*
+ * Histograms of how long generations take to step, to draw, and from one
+ * frame to the next (everything in between, pause included), shown every
+ * LatencyReportEvery seconds while the simulation runs and at the end.
+ */
+
+struct runTimesT {
+    latencyT step;
+    latencyT draw;
+    latencyT frame;
+    int64_t nextReport;     // TraceClock time of the next live report
+};
+
+static void InitRunTimes(runTimesT &times) {
+    InitLatency(times.step);
+    InitLatency(times.draw);
+    InitLatency(times.frame);
+    times.nextReport = TraceClock() + (int64_t) (LatencyReportEvery * 1e9);
+}
+
+/*
+ * Prints the histograms, live ones only once LatencyReportEvery has passed.
+ * Steps timed on another thread are left out of the live reports.
+ */
+
+static void ReportRunTimes(runTimesT &times, bool isFinal, bool withStep) {
+    if (!isFinal) {
+        int64_t now = TraceClock();
+        if (now < times.nextReport) return;
+        times.nextReport = now + (int64_t) (LatencyReportEvery * 1e9);
+    }
+    if (withStep && times.step.total > 0) PrintLatency(cout, "step", times.step);
+    if (times.draw.total > 0) PrintLatency(cout, "draw", times.draw);
+    if (times.frame.total > 0) PrintLatency(cout, "frame", times.frame);
+}
+
+/*
+ * Ludicrous Speed steps the simulation on a thread of its own, as fast as
+ * it will go.  Each generation is exported into a slot of a triple buffer,
+ * and the main thread, waking at the display's refresh rate, draws the
+ * newest one over the last one shown, touching only the cells whose shade
+ * changed.  Generations finished between two refreshes are never drawn,
+ * so drawing cannot hold back the simulation.
+ */
+
+struct simThreadT {
+    lifeSimT *sim;
+    checkpointT *checkpoint;
+    gridLifeT slots[3];
+    tripleBufferT buffer;
+    int stop;                   // set by the main thread to end the run
+    int stabilized;             // set by the simulation thread as it ends
+    latencyT stepTimes;         // kept by the simulation thread
+};
+
+static void *SimThreadMain(void *arg) {
+    simThreadT *thread = (simThreadT *) arg;
+    lifeSimT &sim = *thread->sim;
+    TraceThreadName("simulation");
+    while (!__sync_fetch_and_add(&thread->stop, 0)) {
+        int64_t began = TraceClock();
+        bool isStabilized = StepSim(sim);
+        RecordLatency(thread->stepTimes, TraceClock() - began);
+        sim.gridLife = &thread->slots[thread->buffer.back];
+        SimGrid(sim);
+        Checkpoint(*thread->checkpoint, sim);
+        PublishSlot(thread->buffer);
+        if (isStabilized) {
+            __sync_lock_test_and_set(&thread->stabilized, 1);
+            break;
+        }
+    }
+    return NULL;
+}
+
+static void RunLudicrous(lifeSimT &sim, gridLifeT &gridLife, checkpointT &checkpoint, runTimesT &times) {
+    simThreadT thread;
+    thread.sim = &sim;
+    thread.checkpoint = &checkpoint;
+    for (int k = 0; k < 3; k++) {
+        thread.slots[k].resize(gridLife.numRows(), gridLife.numCols());
+    }
+    InitTripleBuffer(thread.buffer);
+    thread.stop = 0;
+    thread.stabilized = 0;
+    InitLatency(thread.stepTimes);
+
+    pthread_t simThread;
+    if (pthread_create(&simThread, NULL, SimThreadMain, &thread) != 0) {
+        Error("Unable to start the simulation thread");
+    }
+    int framesShown = 0;
+    int64_t lastShown = TraceClock();
+    bool isStabilized = false;
+    while (true) {
+        if (MouseClicked()) {
+            __sync_lock_test_and_set(&thread.stop, 1);
+            break;
+        }
+        // Read the flag before the slot, so the last generation is not missed
+        isStabilized = __sync_fetch_and_add(&thread.stabilized, 0);
+        if (AcquireSlot(thread.buffer)) {
+            int64_t began = TraceClock();
+            DrawGrid(thread.slots[thread.buffer.front]);
+            int64_t now = TraceClock();
+            RecordLatency(times.draw, now - began);
+            RecordLatency(times.frame, now - lastShown);
+            lastShown = now;
+            framesShown++;
+            TRACE_COUNT("frames shown", framesShown);
+        }
+        if (isStabilized) {
+            break;
+        }
+        ReportRunTimes(times, false, false);
+        PauseFor(RefreshInterval);
+    }
+    pthread_join(simThread, NULL);
+    times.step = thread.stepTimes;
+    sim.gridLife = &gridLife;
+    if (isStabilized) {
+        cout << "Colony stablized: " << SimVerdict(sim) << "." << endl;
+    }
+    cout << sim.generation << " generations, " << framesShown << " frames shown." << endl;
 }
 
+/*
+ * PowerPoint Speed steps one generation each time RETURN is pressed, and
+ * keeps a history of the run so earlier generations can be revisited:
+ * "b" steps back one generation and "g N" goes to generation N, stepping
+ * the simulation forward if N is still to come.  A long way forward is
+ * drawn as it goes, and a mouse click stops it where it has got to.
+ * While an earlier generation is shown, RETURN moves forward through the
+ * history until the newest generation is reached again.
+ */
+
+static void RunPowerPoint(lifeSimT &sim, checkpointT &checkpoint, runTimesT &times) {
+    historyT history;
+    InitHistory(history, SimGrid(sim), sim.generation, HistoryBudget);
+    int64_t shown = sim.generation;
+    gridLifeT past;
+    while (true) {
+        cout << "RETURN to continue, \"b\" to go back, \"g N\" to go to generation N (or \"quit\" to end simulation): ";
+        string line = ReadCommand();
+        if (line[0] == 'q') {
+            break;
+        }
+        int64_t target = shown + 1;
+        if (line[0] == 'b') {
+            target = shown - 1;
+        }
+        else if (line[0] == 'g') {
+            target = atoll(line.substr(1).c_str());
+        }
+        if (target <= sim.generation) {
+            if (SeekHistory(history, target, past)) {
+                DrawGrid(past);
+                shown = target;
+                cout << "Generation " << shown << endl;
+            }
+            else {
+                cout << "Generation " << target << " is not in the history, which holds generations "
+                     << HistoryFirst(history) << " to " << HistoryLast(history) << "." << endl;
+            }
+            continue;
+        }
+        bool isStabilized = false;
+        bool stepOnce = (shown == sim.generation && target == sim.generation + 1);
+        bool showProgress = false;
+        int64_t nextProgress = TraceClock() + (int64_t) (SeekProgressEvery * 1e9);
+        while (sim.generation < target && !isStabilized) {
+            int64_t began = TraceClock();
+            isStabilized = StepSim(sim);
+            RecordLatency(times.step, TraceClock() - began);
+            RecordGeneration(history, SimGrid(sim), sim.generation);
+            Checkpoint(checkpoint, sim);
+            if (!stepOnce && TraceClock() >= nextProgress) {
+                if (!showProgress) {
+                    cout << "Going to generation " << target << ", click the mouse to stop." << endl;
+                    showProgress = true;
+                }
+                DrawGrid(SimGrid(sim));
+                if (MouseClicked()) break;
+                nextProgress = TraceClock() + (int64_t) (SeekProgressEvery * 1e9);
+            }
+        }
+        int64_t began = TraceClock();
+        if (stepOnce) {
+            DrawSimGrid(sim);
+        }
+        else {
+            DrawGrid(SimGrid(sim));
+            cout << "Generation " << sim.generation << endl;
+        }
+        RecordLatency(times.draw, TraceClock() - began);
+        shown = sim.generation;
+        if (isStabilized) {
+            cout << "Colony stablized: " << SimVerdict(sim) << "." << endl;
+            break;
+        }
+    }
+}
 
-void RunLifeSim(int simMode, int simSpeed, gridLifeT &gridLife) {
+void RunLifeSim(int simMode, int simSpeed, gridLifeT &gridLife, simEngineT engine) {
     //cout << "Stub for RunLifeSim(" << simSpeed << ", " << simMode << ", GRID= " << gridLife.size.row << ":" << gridLife.size.col << ")" << endl;
     cout << endl;
+    lifeSimT sim;
+    InitSim(sim, gridLife, simMode, engine);
+    checkpointT checkpoint;
+    InitCheckpoint(checkpoint, CheckpointFile, CheckpointEvery, sim);
+    runTimesT times;
+    InitRunTimes(times);
     
     if (simSpeed == 4) {
-        while (true) {
-            cout << "RETURN to continue (or \"quit\" to end simulation): "; 
-            string line = ConvertToLowerCase(GetLine());
-            if (line[0] == 'q') {
-                break;
-            }
-            bool isStabilized = UpdateGrid(gridLife, simMode);
-            DrawGrid(gridLife);
-            if (isStabilized) {
-                cout << "Colony stablized." << endl;
-                break;
-            }
-        }
+        RunPowerPoint(sim, checkpoint, times);
     }
     else {
         double frameRate = (simSpeed - 1) * FrameRateMuliplier * ((simSpeed == 3) ? FrameRateAdjustment : 1);
         cout << "Click and hold the mouse button on the graphics window to end the simulation." << endl;
-        while (true) {
-            if (MouseButtonIsDown()) {
-                break;
+        if (simSpeed == 1) {
+            RunLudicrous(sim, gridLife, checkpoint, times);
+        }
+        else {
+            perfCountersT counters;
+            perfTotalsT stepCounts, drawCounts;
+            InitPerfTotals(stepCounts);
+            InitPerfTotals(drawCounts);
+            bool isCounting = (getenv(PerfVariable) != NULL && OpenPerfCounters(counters));
+            double cells = double(gridLife.numRows()) * gridLife.numCols();
+            int64_t frameBegan = TraceClock();
+            while (true) {
+                if (MouseClicked()) {
+                    break;
+                }
+                if (isCounting) BeginPerf(counters);
+                int64_t began = TraceClock();
+                bool isStabilized = StepSim(sim);
+                RecordLatency(times.step, TraceClock() - began);
+                if (isCounting) EndPerf(counters, stepCounts, cells);
+                if (isCounting) BeginPerf(counters);
+                began = TraceClock();
+                DrawSimGrid(sim);
+                RecordLatency(times.draw, TraceClock() - began);
+                if (isCounting) EndPerf(counters, drawCounts, cells);
+                Checkpoint(checkpoint, sim);
+                if (isStabilized) {
+                    cout << "Colony stablized: " << SimVerdict(sim) << "." << endl;
+                    break;
+                }
+                ReportRunTimes(times, false, true);
+                PauseFor(frameRate);
+                int64_t now = TraceClock();
+                RecordLatency(times.frame, now - frameBegan);
+                frameBegan = now;
             }
-            bool isStabilized = UpdateGrid(gridLife, simMode);
-            DrawGrid(gridLife);
-            if (isStabilized) {
-                cout << "Colony stablized." << endl;
-                break;
+            if (isCounting) {
+                PrintPerf(cout, "step", counters, stepCounts);
+                PrintPerf(cout, "draw", counters, drawCounts);
+                ClosePerfCounters(counters);
             }
-            Pause(frameRate);
         }
     }
+    ReportRunTimes(times, true, true);
 }
 
 void PrintCell(int point) {
@@ -120,7 +415,7 @@ void ShowGrid(gridLifeT &gridLife) {
     for (int i = 0; i < gridLife.numRows(); i++) {
         cout << " ";
         for (int j = 0; j < gridLife.numCols(); j++) {
-            cout << gridLife[i][j];
+            cout << int(gridLife[i][j]);
             string spacer = ((gridLife[i][j]) > 9) ? " " : "  ";
             cout << spacer;
         }
@@ -129,131 +424,259 @@ void ShowGrid(gridLifeT &gridLife) {
 }
 
 /*
- * Calculates life for the next step and updates the Grid by reference based on the given simMode.
- * Also, checks for stability of colony on-going during the update process.
+ * Boundary policies
+ * -----------------
+ * Each policy says which on-board row or column an index off the board
+ * shows, or -1 when nothing is there.  StepGrid is instantiated once per
+ * policy, so the simMode is looked at once, when the state is set up.
+ *
+ * In Donut Mode, the grid wraps around like a torus to check "neighborship".
+ *
+ * In Mirror Mode, off the edge cells are a relection of what is on the grid:
+ * one step off the edge sees the edge cell itself, two steps the next one in.
  */
 
+struct PlateauEdges {
+    static const bool fillsHalo = false;    // the halo stays empty
+    static int Wrap(int index, int n) {
+        return (index < 0 || index >= n) ? -1 : index;
+    }
+};
 
-bool UpdateGrid(gridLifeT &gridLife, int simMode) {
-    gridLifeT gridLife2 = gridLife;
-    bool isStabilized = true;
-    int rows = gridLife.numRows();
-    int cols = gridLife.numCols();
-    
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < cols; j++) {
-            int neighbors = CheckForNeighbors(gridLife2, i, j, simMode, rows, cols);
-            int age = gridLife[i][j];
-            switch (neighbors) {
-                case 2:
-                    if (age < MaxAge) {
-                        gridLife[i][j] += (age != 0) ? 1 : 0;
-                    }
-                    break;
-                case 3:
-                    if (age < MaxAge) {
-                        gridLife[i][j] += 1;
+struct DonutEdges {
+    static const bool fillsHalo = true;
+    static int Wrap(int index, int n) {
+        return ((index % n) + n) % n;
+    }
+};
+
+struct MirrorEdges {
+    static const bool fillsHalo = true;
+    static int Wrap(int index, int n) {
+        int m = ((index % (2 * n)) + 2 * n) % (2 * n);
+        return (m < n) ? m : 2 * n - 1 - m;
+    }
+};
+
+/*
+ * Returns a pointer to column 0 of the given row of a padded plane.
+ * Rows and columns from -halo up to numRows/numCols + halo - 1 are valid.
+ */
+
+static inline cellT *PlaneRow(lifeStateT &state, std::vector<cellT> &plane, int row) {
+    return &plane[(row + state.halo) * state.stride + state.halo];
+}
+
+/*
+ * Copies the cells the Edges policy says lie just off the board into the
+ * halo.  Columns are done first for every board row, then whole padded
+ * rows are copied for the top and bottom halo, which fills the corners.
+ */
+
+template <typename Edges>
+static void FillHalo(lifeStateT &state, std::vector<cellT> &plane) {
+    if (!Edges::fillsHalo) return;
+    int h = state.halo;
+    for (int i = 0; i < state.nRows; i++) {
+        cellT *row = PlaneRow(state, plane, i);
+        for (int j = 1; j <= h; j++) {
+            row[-j] = row[Edges::Wrap(-j, state.nCols)];
+            row[state.nCols - 1 + j] = row[Edges::Wrap(state.nCols - 1 + j, state.nCols)];
+        }
+    }
+    for (int i = 1; i <= h; i++) {
+        int top = Edges::Wrap(-i, state.nRows);
+        int bottom = Edges::Wrap(state.nRows - 1 + i, state.nRows);
+        copy(PlaneRow(state, plane, top) - h, PlaneRow(state, plane, top) - h + state.stride,
+             PlaneRow(state, plane, -i) - h);
+        copy(PlaneRow(state, plane, bottom) - h, PlaneRow(state, plane, bottom) - h + state.stride,
+             PlaneRow(state, plane, state.nRows - 1 + i) - h);
+    }
+}
+
+/*
+ * Active tiles
+ * ------------
+ * The board is divided into tiles of TileRows by TileCols cells, and each
+ * step records which tiles changed.  A tile's next generation depends only
+ * on its own cells and the ring of cells around it, so a tile is stepped
+ * only when it or one of its eight neighbors changed last generation.
+ *
+ * A tile that is skipped already holds the right cells in the idle plane:
+ * that plane holds the previous generation, and the tile did not change.
+ * Nor can a skipped tile hold a young cell, since young cells age and so
+ * change every generation, which keeps the stability test exact.
+ *
+ * Neighboring tiles are found through the same boundary policy as cells,
+ * so Donut tiles wrap around and Mirror edge tiles see themselves.
+ */
+
+template <typename Edges>
+static void MarkActiveTiles(lifeStateT &state) {
+    state.activeTiles = 0;
+    for (int tr = 0; tr < state.nTileRows; tr++) {
+        for (int tc = 0; tc < state.nTileCols; tc++) {
+            bool active = false;
+            for (int dRow = -1; dRow <= 1 && !active; dRow++) {
+                int r = Edges::Wrap(tr + dRow, state.nTileRows);
+                if (r < 0) continue;
+                for (int dCol = -1; dCol <= 1; dCol++) {
+                    int c = Edges::Wrap(tc + dCol, state.nTileCols);
+                    if (c >= 0 && state.tileChanged[r * state.nTileCols + c]) {
+                        active = true;
+                        break;
                     }
-                    break;
-                default:
-                    gridLife[i][j] = 0;
-                    break;
-            }
-            age = gridLife[i][j];
-            if (isStabilized && (age > 0 && age < MaxAge)) {
-                //cout << " UpdatedGrid: isStabilize false at: " << i << ":" << j << endl;
-                isStabilized = false;
+                }
             }
+            state.tileActive[tr * state.nTileCols + tc] = active;
+            state.activeTiles += active;
         }
     }
-    return isStabilized;
 }
 
-int CheckForNeighbors(gridLifeT &gridLife, int row, int col, int simMode, int nRows, int nCols) {
-    int count = 0;
-    
-    for (int dRow = -1; dRow <= 1; dRow++) {
-        for (int dCol = -1; dCol <= 1; dCol++) {
-            count += IsDirectionOccupied(gridLife, row, col, simMode, dRow, dCol, nRows, nCols);
+/*
+ * Steps the active tiles in tile rows [first, last) of state into the idle
+ * plane, noting which of them changed.  Returns nonzero if any cell it
+ * wrote is alive but younger than MaxAge.
+ */
+
+static int StepTileRows(lifeStateT &state, int first, int last) {
+    std::vector<cellT> &gridLife = state.buffer[state.current];      // this generation, read only
+    std::vector<cellT> &gridNext = state.buffer[1 - state.current];  // next generation, written
+    int young = 0;
+    for (int tr = first; tr < last; tr++) {
+        int firstRow = tr * TileRows;
+        int lastRow = min(firstRow + TileRows, state.nRows);
+        for (int tc = 0; tc < state.nTileCols; tc++) {
+            int tile = tr * state.nTileCols + tc;
+            state.tileNext[tile] = false;
+            if (!state.tileActive[tile]) continue;
+            int col = tc * TileCols;
+            int width = min(TileCols, state.nCols - col);
+            bool changed = false;
+            for (int i = firstRow; i < lastRow; i++) {
+                const cellT *mid = PlaneRow(state, gridLife, i) + col;
+                cellT *out = PlaneRow(state, gridNext, i) + col;
+                young |= state.kernel(PlaneRow(state, gridLife, i - 1) + col, mid,
+                                      PlaneRow(state, gridLife, i + 1) + col, out, width);
+                changed = changed || memcmp(mid, out, width) != 0;
+            }
+            state.tileNext[tile] = changed;
         }
     }
-    return count;
+    return young;
 }
 
-/**
- * Function: OnBoard
- * (modified from: 08-Velociraptor-Safety.pdf, Stanford Univerity)
+/*
+ * Parallel stepping
  * -----------------
- * OnBoard is a predicate function that returns true if and only if the
- * specified coordinate indexes a legal entry of the lifeGrid.
+ * Grids of at least MinParallelCells are cut into one horizontal band of
+ * tile rows per worker.  Tiles only read the current plane, so bands never
+ * interfere and the result is the same for any number of workers.  Each
+ * worker writes its stability result once, into its own cache line.
  */
 
-bool OnBoard(int row, int col, int nRows, int nCols) {
-    return (row >= 0 && row < nRows &&
-            col >= 0 && col < nCols);
+const int MinParallelCells = 1 << 16;
+
+struct workerFlagT {
+    int young;
+    char pad[CacheLineSize - sizeof(int)];
+};
+
+struct bandJobT {
+    lifeStateT *state;
+    workerFlagT flags[MaxWorkers];
+};
+
+static void StepBand(void *context, int worker, int nWorkers) {
+    bandJobT *job = (bandJobT *) context;
+    int tileRows = job->state->nTileRows;
+    job->flags[worker].young = StepTileRows(*job->state, tileRows * worker / nWorkers,
+                                            tileRows * (worker + 1) / nWorkers);
 }
 
-/**
- * Function: IsDirectionOccupied
- * (modified from: 08-Velociraptor-Safety.pdf, Stanford Univerity)
- * -------------------------
- * IsDirectionOccupied decides whether or not a neighbor can be seen
- * by looking from the specified (row, col) coordinate in a particular
- * direction--specified by arguments four and five in the form of exactly
- * what values should be added to (row, col) to look in a specified
- * direction.
- *
- * Assuming that the origin (0,0) coincides with the lower left corner of
- * then board, IsDirectionOccupied must examine the coordinates * (row + dRow, col + dCol), (row + 2 * dRow, col + 2 * dCol)
- * to see if neighbors are adjacent.
- *
- * In Donut Mode, IsDirectionOccupied wraps the grid around like a torus to check "neighborship".
- *
- * In Mirror Mode, off the edge cells are a relection of what is on the grid.
+/*
+ * Calculates the next generation.  The halo is filled for the boundary
+ * mode first, after which every active tile, edges included, goes through
+ * the same row kernel with no bounds checks.
  */
 
-bool IsDirectionOccupied(gridLifeT &gridLife, int row, int col, int simMode,int dRow, int dCol, int nRows, int nCols) {    
-    if ((dRow == 0) && (dCol == 0)) return false; // protect against bad call
-    row += dRow;
-    col += dCol;
-    if (simMode == 0 ) { //|| row != 0 || col != 0) { // Plateau
-        return (OnBoard(row, col, nRows, nCols) && gridLife[row][col] > 0);
-    }
-    else if (simMode == 1) { // Donut
-        if (row < 0) {
-            row = nRows - 1;
-        }
-        else if (row == nRows) {
-            row = 0;
-        }
-        if (col < 0) {
-            col = nCols - 1;
-        }
-        else if (col == nCols) {
-            col = 0;
-        }
-    }
-    else if (simMode == 2) { // Mirror
-        if (row < 0) {
-            row = 0;
-        }
-        else if (row == nRows) {
-            row = nRows - 1;
-        }
-        if (col < 0) {
-            col = 0;
-        }
-        else if (col == nCols) {
-            col = nCols - 1;
+template <typename Edges>
+static bool StepGrid(lifeStateT &state) {
+    FillHalo<Edges>(state, state.buffer[state.current]);
+    MarkActiveTiles<Edges>(state);
+    int young = 0;
+    int nWorkers = WorkerCount();
+
+    if (nWorkers > 1 && state.nTileRows >= nWorkers && state.nRows * state.nCols >= MinParallelCells) {
+        bandJobT job;
+        job.state = &state;
+        RunWorkers(StepBand, &job);
+        for (int k = 0; k < nWorkers; k++) {
+            young |= job.flags[k].young;
         }
     }
     else {
-        Error("Bad simMode detected");
+        young = StepTileRows(state, 0, state.nTileRows);
     }
-    return (gridLife[row][col] > 0);
+    state.tileChanged.swap(state.tileNext);
+    state.current = 1 - state.current;
+    return !young;
 }
 
+template <typename CellT>
+void InitLifeState(lifeStateT &state, Grid<CellT> &gridLife, int simMode) {
+    state.nRows = gridLife.numRows();
+    state.nCols = gridLife.numCols();
+    state.halo = HaloWidth;
+    state.stride = state.nCols + 2 * state.halo;
+    int planeSize = (state.nRows + 2 * state.halo) * state.stride;
+    state.buffer[0].assign(planeSize, 0);
+    state.buffer[1].assign(planeSize, 0);
+    state.current = 0;
+    state.kernel = RowKernelFor(BestSimdLevel());
+    state.nTileRows = (state.nRows + TileRows - 1) / TileRows;
+    state.nTileCols = (state.nCols + TileCols - 1) / TileCols;
+    state.tileChanged.assign(state.nTileRows * state.nTileCols, true);  // first step does every tile
+    state.tileNext.assign(state.nTileRows * state.nTileCols, false);
+    state.tileActive.assign(state.nTileRows * state.nTileCols, false);
+    state.activeTiles = 0;
+    for (int i = 0; i < state.nRows; i++) {
+        cellT *row = PlaneRow(state, state.buffer[0], i);
+        for (int j = 0; j < state.nCols; j++) {
+            int age = gridLife[i][j];
+            row[j] = (age < MaxAge) ? age : MaxAge;
+        }
+    }
+    switch (simMode) {
+        case 0: state.step = StepGrid<PlateauEdges>; break;
+        case 1: state.step = StepGrid<DonutEdges>; break;
+        case 2: state.step = StepGrid<MirrorEdges>; break;
+        default: Error("Bad simMode detected");
+    }
+}
 
+template <typename CellT>
+void StateToGrid(lifeStateT &state, Grid<CellT> &gridLife) {
+    for (int i = 0; i < state.nRows; i++) {
+        const cellT *row = PlaneRow(state, state.buffer[state.current], i);
+        for (int j = 0; j < state.nCols; j++) {
+            gridLife[i][j] = row[j];
+        }
+    }
+}
 
+template void InitLifeState(lifeStateT &state, Grid<int> &gridLife, int simMode);
+template void InitLifeState(lifeStateT &state, Grid<cellT> &gridLife, int simMode);
+template void StateToGrid(lifeStateT &state, Grid<int> &gridLife);
+template void StateToGrid(lifeStateT &state, Grid<cellT> &gridLife);
 
+/*
+ * Calculates life for the next step into the idle buffer of state,
+ * then makes that buffer the current one.
+ * Also, checks for stability of colony on-going during the update process.
+ */
 
+bool UpdateGrid(lifeStateT &state) {
+    return state.step(state);
+}
@@ -15,23 +15,122 @@
 #ifndef life_lifeGrid_h
 #define life_lifeGrid_h
 
+#include <vector>
+
+#include "lifeKernel.h"
+
 struct gridSizeT {
     int row;
     int col;
 };
 
-typedef Grid<int> gridLifeT;
+/*
+ * Type: gridLifeT
+ * ---------------
+ * A window of cells by age, as loaded, exported and drawn.  No age passes
+ * MaxAge, so each cell is a cellT byte, a quarter of the memory and
+ * bandwidth an int took.  The routines that read or write cells are
+ * templated on the cell type, so grids of other widths still work.
+ */
+
+typedef Grid<cellT> gridLifeT;
+
+/*
+ * The stepping engines a simulation can run on.  The standard and
+ * bit-packed engines give the same generations in the bounded simModes
+ * (0 Plateau, 1 Donut, 2 Mirror).  Infinite Mode (simMode 3) always runs
+ * on the live-cell engine, and HashLife always runs on an unbounded plane.
+ */
+
+enum simEngineT {
+    DenseEngine,    // one byte per cell, neighbors counted by a row kernel
+    BitEngine,      // 64 cells per word, neighbors counted bitwise
+    HashEngine,     // memoized quadtree, steps of 2^k generations
+    SparseEngine    // live cells only, on an unbounded plane
+};
+
+/*
+ * Draws gridLife over the grid last drawn, redrawing only the cells
+ * whose shade changed
+ */
+
+template <typename CellT>
+void DrawGrid(Grid<CellT> &gridLife);
+
+/*
+ * Width of the ghost border kept around each plane of lifeStateT.
+ */
+
+const int HaloWidth = 1;
+
+/*
+ * Size of the tiles lifeStateT tracks changes in.  A tile row is as wide
+ * as the widest row kernel handles at once.
+ */
+
+const int TileRows = 16;
+const int TileCols = 64;
+
+/*
+ * Holds the two planes the standard engine steps between, each with one
+ * byte (the cell's age) per cell.  Each generation is read from one plane
+ * and written to the other, then the two swap roles, so nothing is
+ * allocated or copied once the state is set up.
+ *
+ * Each plane is padded with a halo of HaloWidth ghost cells on every side.
+ * Before a generation is stepped the halo is filled with what the boundary
+ * mode says lies off the edge (nothing for Plateau, the far side for Donut,
+ * the reflected edge for Mirror), so the stepping loop never bounds-checks.
+ *
+ * The board is also cut into tiles, and only tiles that could change are
+ * recomputed; tileChanged tells which tiles differ from the generation
+ * before, which is also what needs redrawing.
+ */
+
+struct lifeStateT {
+    int nRows;
+    int nCols;
+    int halo;               // ghost cells on each side of the board
+    int stride;             // cells from one padded row to the next
+    std::vector<cellT> buffer[2];
+    int current;            // index of the buffer holding this generation
+    bool (*step)(lifeStateT &state);  // stepping loop built for the simMode
+    rowKernelT kernel;      // widest row kernel this processor supports
+    int nTileRows;
+    int nTileCols;
+    std::vector<unsigned char> tileChanged;  // tiles that changed in the last step
+    std::vector<unsigned char> tileNext;     // tiles changing in the step under way
+    std::vector<unsigned char> tileActive;   // tiles the step under way recomputes
+    int activeTiles;                         // how many tiles the last step recomputed
+};
+
+/*
+ * Sets up state with a copy of gridLife as its current generation, to be
+ * stepped in the given simMode (0 Plateau, 1 Donut, 2 Mirror).
+ */
+
+template <typename CellT>
+void InitLifeState(lifeStateT &state, Grid<CellT> &gridLife, int simMode);
+
+/*
+ * Copies the current generation of state into gridLife, which must
+ * already be sized to match.
+ */
+
+template <typename CellT>
+void StateToGrid(lifeStateT &state, Grid<CellT> &gridLife);
 
 /*
- * Draws a fresh grid unto the graphics window
+ * Calculates the next generation of state.
+ * Returns true once every live cell has reached MaxAge.
  */
 
-void DrawGrid(gridLifeT &gridLife);
+bool UpdateGrid(lifeStateT &state);
 
 /* 
  * Handles the various modes of the game and kicks off the life simulation
  */
 
-void RunLifeSim(int simMode, int simSpeed, gridLifeT &gridLife);
+void RunLifeSim(int simMode, int simSpeed, gridLifeT &gridLife, simEngineT engine);
 
 #endif
@@ -0,0 +1,462 @@
+//
+//  lifeHash.cpp
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+#include <algorithm>
+#include <climits>
+#include <utility>
+
+#include "genlib.h"
+#include "grid.h"
+
+#include "lifeHash.h"
+
+const int DeadLeaf = 0;
+const int LiveLeaf = 1;
+const int MinRootLevel = 3;
+const int DefaultMaxNodes = 1 << 22;
+
+static int Join(hashLifeT &life, int nw, int ne, int sw, int se);
+static int EmptyNode(hashLifeT &life, int level);
+static int Expand(hashLifeT &life, int n);
+static int Center(hashLifeT &life, int n);
+static int Advance(hashLifeT &life, int n, int stepLog);
+static void GrowRoot(hashLifeT &life, int stepLog);
+static int BuildNode(hashLifeT &life, gridLifeT &gridLife, int level, int row, int col);
+static void FillWindow(hashLifeT &life, int n, int64_t row, int64_t col, gridLifeT &gridLife);
+static void CollectCells(hashLifeT &life, int n, int64_t row, int64_t col, std::vector<std::pair<int64_t, int64_t> > &cells);
+static void CollectGarbage(hashLifeT &life, bool dropResults);
+
+static void AddLeaf(hashLifeT &life, int alive) {
+    hashNodeT leaf;
+    leaf.nw = leaf.ne = leaf.sw = leaf.se = -1;
+    leaf.level = 0;
+    leaf.population = alive;
+    leaf.result = leaf.stepResult = -1;
+    leaf.stepLog = -1;
+    leaf.next = -1;
+    leaf.marked = true;
+    life.nodes.push_back(leaf);
+}
+
+void InitHashLife(hashLifeT &life, gridLifeT &gridLife) {
+    life.nodes.clear();
+    life.buckets.assign(1 << 16, -1);
+    life.empties.clear();
+    life.freeList = -1;
+    life.liveNodes = 0;
+    life.maxNodes = DefaultMaxNodes;
+    life.generation = 0;
+    AddLeaf(life, 0);   // DeadLeaf
+    AddLeaf(life, 1);   // LiveLeaf
+    life.empties.push_back(DeadLeaf);
+
+    int level = MinRootLevel;
+    while ((1 << level) < gridLife.numRows() || (1 << level) < gridLife.numCols()) {
+        level++;
+    }
+    life.root = BuildNode(life, gridLife, level, 0, 0);
+    life.originRow = 0;
+    life.originCol = 0;
+}
+
+/*
+ * Before stepping 2^stepLog generations the root is grown until it is at
+ * least stepLog + 3 levels high and the whole pattern sits inside its
+ * central quarter.  The pattern can then spread no further than the
+ * center half, which is exactly what Advance returns, so nothing is lost.
+ * The result is padded back out by one level so it lines up with the old
+ * root, which makes "nothing changed" a single comparison.
+ */
+
+bool StepHashLife(hashLifeT &life, int stepLog) {
+    GrowRoot(life, stepLog);
+    int before = life.root;
+    life.root = Expand(life, Advance(life, life.root, stepLog));
+    life.generation += int64_t(1) << stepLog;
+
+    if (life.liveNodes > life.maxNodes) {
+        CollectGarbage(life, false);
+        if (life.liveNodes > life.maxNodes / 2) {
+            CollectGarbage(life, true);
+        }
+    }
+    return life.root == before;
+}
+
+/*
+ * The period divides 2^stepLog, so it is a power of two.  Each candidate
+ * is tried on the root as it stands, which leaves the universe as it was.
+ */
+
+int64_t HashLifePeriod(hashLifeT &life, int stepLog) {
+    GrowRoot(life, stepLog);
+    for (int k = 0; k < stepLog; k++) {
+        if (Expand(life, Advance(life, life.root, k)) == life.root) {
+            return int64_t(1) << k;
+        }
+    }
+    return int64_t(1) << stepLog;
+}
+
+void HashLifeToGrid(hashLifeT &life, gridLifeT &gridLife) {
+    for (int i = 0; i < gridLife.numRows(); i++) {
+        for (int j = 0; j < gridLife.numCols(); j++) {
+            gridLife[i][j] = 0;
+        }
+    }
+    FillWindow(life, life.root, life.originRow, life.originCol, gridLife);
+}
+
+bool HashLifeToSparse(hashLifeT &life, sparseLifeT &sparse) {
+    std::vector<std::pair<int64_t, int64_t> > found;
+    CollectCells(life, life.root, 0, 0, found);
+    std::sort(found.begin(), found.end());
+    sparse.cells.clear();
+    sparse.nRows = sparse.nCols = 0;
+    if (found.empty()) return true;
+    int64_t top = found.front().first, bottom = found.back().first;
+    int64_t left = found[0].second, right = found[0].second;
+    for (size_t k = 1; k < found.size(); k++) {
+        left = std::min(left, found[k].second);
+        right = std::max(right, found[k].second);
+    }
+    if (bottom - top >= INT_MAX || right - left >= INT_MAX) return false;
+    sparse.cells.resize(found.size());
+    for (size_t k = 0; k < found.size(); k++) {
+        sparse.cells[k].row = (int) (found[k].first - top);
+        sparse.cells[k].col = (int) (found[k].second - left);
+        sparse.cells[k].age = 1;
+    }
+    sparse.nRows = (int) (bottom - top + 1);
+    sparse.nCols = (int) (right - left + 1);
+    return true;
+}
+
+double HashLifePopulation(hashLifeT &life) {
+    return life.nodes[life.root].population;
+}
+
+/*
+ * Node construction
+ * -----------------
+ * Join returns the one node with the given quadrants, making it if it is
+ * not in the hash table yet.  Nodes are referred to by index because the
+ * node vector may move as it grows.
+ */
+
+static unsigned HashOf(int nw, int ne, int sw, int se) {
+    unsigned h = (unsigned) nw * 2654435761u;
+    h = (h ^ (unsigned) ne) * 2246822519u;
+    h = (h ^ (unsigned) sw) * 3266489917u;
+    h = (h ^ (unsigned) se) * 668265263u;
+    return h ^ (h >> 15);
+}
+
+static void GrowBuckets(hashLifeT &life) {
+    life.buckets.assign(life.buckets.size() * 2, -1);
+    int mask = (int) life.buckets.size() - 1;
+    for (int i = 2; i < (int) life.nodes.size(); i++) {
+        hashNodeT &node = life.nodes[i];
+        if (node.level < 0) continue;
+        int b = HashOf(node.nw, node.ne, node.sw, node.se) & mask;
+        node.next = life.buckets[b];
+        life.buckets[b] = i;
+    }
+}
+
+static int Join(hashLifeT &life, int nw, int ne, int sw, int se) {
+    int b = HashOf(nw, ne, sw, se) & ((int) life.buckets.size() - 1);
+    for (int i = life.buckets[b]; i >= 0; i = life.nodes[i].next) {
+        hashNodeT &node = life.nodes[i];
+        if (node.nw == nw && node.ne == ne && node.sw == sw && node.se == se) {
+            return i;
+        }
+    }
+    hashNodeT node;
+    node.nw = nw;
+    node.ne = ne;
+    node.sw = sw;
+    node.se = se;
+    node.level = life.nodes[nw].level + 1;
+    node.population = life.nodes[nw].population + life.nodes[ne].population
+                    + life.nodes[sw].population + life.nodes[se].population;
+    node.result = node.stepResult = -1;
+    node.stepLog = -1;
+    node.marked = false;
+    node.next = life.buckets[b];
+
+    int i;
+    if (life.freeList >= 0) {
+        i = life.freeList;
+        life.freeList = life.nodes[i].next;
+        life.nodes[i] = node;
+    }
+    else {
+        i = (int) life.nodes.size();
+        life.nodes.push_back(node);
+    }
+    life.buckets[b] = i;
+    life.liveNodes++;
+    if (life.liveNodes > (int) life.buckets.size()) {
+        GrowBuckets(life);
+    }
+    return i;
+}
+
+static int EmptyNode(hashLifeT &life, int level) {
+    while ((int) life.empties.size() <= level) {
+        int e = life.empties.back();
+        life.empties.push_back(Join(life, e, e, e, e));
+    }
+    return life.empties[level];
+}
+
+/*
+ * Returns a node one level up with n in its middle.
+ */
+
+static int Expand(hashLifeT &life, int n) {
+    hashNodeT node = life.nodes[n];
+    int e = EmptyNode(life, node.level - 1);
+    return Join(life,
+                Join(life, e, e, e, node.nw), Join(life, e, e, node.ne, e),
+                Join(life, e, node.sw, e, e), Join(life, node.se, e, e, e));
+}
+
+/*
+ * Returns the middle half of n, one level down, without stepping it.
+ */
+
+static int Center(hashLifeT &life, int n) {
+    hashNodeT node = life.nodes[n];
+    return Join(life, life.nodes[node.nw].se, life.nodes[node.ne].sw,
+                life.nodes[node.sw].ne, life.nodes[node.se].nw);
+}
+
+/*
+ * Steps the 4x4 node n by one generation by hand and returns its middle 2x2.
+ */
+
+static int BaseResult(hashLifeT &life, int n) {
+    int cells[4][4];
+    int quads[4] = { life.nodes[n].nw, life.nodes[n].ne, life.nodes[n].sw, life.nodes[n].se };
+    for (int q = 0; q < 4; q++) {
+        hashNodeT &quad = life.nodes[quads[q]];
+        int row = (q / 2) * 2;
+        int col = (q % 2) * 2;
+        cells[row][col] = quad.nw;
+        cells[row][col + 1] = quad.ne;
+        cells[row + 1][col] = quad.sw;
+        cells[row + 1][col + 1] = quad.se;
+    }
+    int next[2][2];
+    for (int i = 1; i <= 2; i++) {
+        for (int j = 1; j <= 2; j++) {
+            int neighbors = 0;
+            for (int dRow = -1; dRow <= 1; dRow++) {
+                for (int dCol = -1; dCol <= 1; dCol++) {
+                    if (dRow != 0 || dCol != 0) neighbors += cells[i + dRow][j + dCol];
+                }
+            }
+            next[i - 1][j - 1] = (neighbors == 3 || (neighbors == 2 && cells[i][j])) ? LiveLeaf : DeadLeaf;
+        }
+    }
+    return Join(life, next[0][0], next[0][1], next[1][0], next[1][1]);
+}
+
+/*
+ * Grows the root, moving the origin to match, until it can be advanced
+ * 2^stepLog generations without losing any cells.
+ */
+
+static void GrowRoot(hashLifeT &life, int stepLog) {
+    while (true) {
+        int level = life.nodes[life.root].level;
+        if (level >= stepLog + MinRootLevel) {
+            int inner = Center(life, Center(life, life.root));
+            if (life.nodes[inner].population == life.nodes[life.root].population) break;
+        }
+        int64_t half = int64_t(1) << (level - 1);
+        life.root = Expand(life, life.root);
+        life.originRow -= half;
+        life.originCol -= half;
+    }
+}
+
+/*
+ * Returns the middle half of n advanced by 2^stepLog generations, where
+ * stepLog is at most n's level - 2.  n is cut into nine overlapping
+ * sub-squares one level down.  At full speed (stepLog == level - 2) each
+ * is advanced half the way, regrouped into four squares, and advanced the
+ * other half.  For smaller steps the nine are only trimmed to their middles
+ * the first time, and the four are advanced the whole way.
+ */
+
+static int Advance(hashLifeT &life, int n, int stepLog) {
+    hashNodeT node = life.nodes[n];
+    if (node.population == 0) {
+        return EmptyNode(life, node.level - 1);
+    }
+    bool fullSpeed = (stepLog == node.level - 2);
+    if (fullSpeed && node.result >= 0) return node.result;
+    if (!fullSpeed && node.stepLog == stepLog && node.stepResult >= 0) return node.stepResult;
+
+    int result;
+    if (node.level == 2) {
+        result = BaseResult(life, n);
+    }
+    else {
+        hashNodeT a = life.nodes[node.nw];
+        hashNodeT b = life.nodes[node.ne];
+        hashNodeT c = life.nodes[node.sw];
+        hashNodeT d = life.nodes[node.se];
+        int sub[9];
+        sub[0] = node.nw;
+        sub[1] = Join(life, a.ne, b.nw, a.se, b.sw);
+        sub[2] = node.ne;
+        sub[3] = Join(life, a.sw, a.se, c.nw, c.ne);
+        sub[4] = Join(life, a.se, b.sw, c.ne, d.nw);
+        sub[5] = Join(life, b.sw, b.se, d.nw, d.ne);
+        sub[6] = node.sw;
+        sub[7] = Join(life, c.ne, d.nw, c.se, d.sw);
+        sub[8] = node.se;
+
+        int half[9];
+        for (int k = 0; k < 9; k++) {
+            half[k] = fullSpeed ? Advance(life, sub[k], stepLog - 1) : Center(life, sub[k]);
+        }
+        int rest = fullSpeed ? stepLog - 1 : stepLog;
+        int nw = Advance(life, Join(life, half[0], half[1], half[3], half[4]), rest);
+        int ne = Advance(life, Join(life, half[1], half[2], half[4], half[5]), rest);
+        int sw = Advance(life, Join(life, half[3], half[4], half[6], half[7]), rest);
+        int se = Advance(life, Join(life, half[4], half[5], half[7], half[8]), rest);
+        result = Join(life, nw, ne, sw, se);
+    }
+    if (fullSpeed) {
+        life.nodes[n].result = result;
+    }
+    else {
+        life.nodes[n].stepResult = result;
+        life.nodes[n].stepLog = stepLog;
+    }
+    return result;
+}
+
+/*
+ * Builds the node of the given level whose upper left cell is (row, col)
+ * of gridLife.  Cells beyond the grid are dead.
+ */
+
+static int BuildNode(hashLifeT &life, gridLifeT &gridLife, int level, int row, int col) {
+    if (row >= gridLife.numRows() || col >= gridLife.numCols()) {
+        return EmptyNode(life, level);
+    }
+    if (level == 0) {
+        return (gridLife[row][col] > 0) ? LiveLeaf : DeadLeaf;
+    }
+    int half = 1 << (level - 1);
+    int nw = BuildNode(life, gridLife, level - 1, row, col);
+    int ne = BuildNode(life, gridLife, level - 1, row, col + half);
+    int sw = BuildNode(life, gridLife, level - 1, row + half, col);
+    int se = BuildNode(life, gridLife, level - 1, row + half, col + half);
+    return Join(life, nw, ne, sw, se);
+}
+
+/*
+ * Marks the live cells of node n, whose upper left cell is (row, col)
+ * relative to the window, into gridLife.  Empty nodes and nodes wholly
+ * outside the window are skipped.
+ */
+
+static void FillWindow(hashLifeT &life, int n, int64_t row, int64_t col, gridLifeT &gridLife) {
+    hashNodeT &node = life.nodes[n];
+    int64_t size = int64_t(1) << node.level;
+    if (node.population == 0 || row >= gridLife.numRows() || col >= gridLife.numCols()
+        || row + size <= 0 || col + size <= 0) {
+        return;
+    }
+    if (node.level == 0) {
+        gridLife[(int) row][(int) col] = 1;
+        return;
+    }
+    int64_t half = size / 2;
+    int nw = node.nw, ne = node.ne, sw = node.sw, se = node.se;
+    FillWindow(life, nw, row, col, gridLife);
+    FillWindow(life, ne, row, col + half, gridLife);
+    FillWindow(life, sw, row + half, col, gridLife);
+    FillWindow(life, se, row + half, col + half, gridLife);
+}
+
+/*
+ * Garbage collection
+ * ------------------
+ * Marks every node reachable from the root and the empty nodes, through
+ * quadrants and remembered results, then puts the rest on the free list
+ * and rebuilds the hash chains.  If that does not free enough, the
+ * remembered results are dropped as well, keeping only the pattern.
+ */
+
+static void Mark(hashLifeT &life, int n) {
+    if (n < 0 || life.nodes[n].marked) return;
+    life.nodes[n].marked = true;
+    hashNodeT &node = life.nodes[n];
+    int quads[6] = { node.nw, node.ne, node.sw, node.se, node.result, node.stepResult };
+    for (int k = 0; k < 6; k++) {
+        Mark(life, quads[k]);
+    }
+}
+
+static void CollectGarbage(hashLifeT &life, bool dropResults) {
+    for (int i = 2; i < (int) life.nodes.size(); i++) {
+        life.nodes[i].marked = false;
+        if (dropResults) {
+            life.nodes[i].result = life.nodes[i].stepResult = -1;
+        }
+    }
+    Mark(life, life.root);
+    for (int k = 0; k < (int) life.empties.size(); k++) {
+        Mark(life, life.empties[k]);
+    }
+    life.buckets.assign(life.buckets.size(), -1);
+    int mask = (int) life.buckets.size() - 1;
+    life.freeList = -1;
+    life.liveNodes = 0;
+    for (int i = (int) life.nodes.size() - 1; i >= 2; i--) {
+        hashNodeT &node = life.nodes[i];
+        if (node.marked) {
+            int b = HashOf(node.nw, node.ne, node.sw, node.se) & mask;
+            node.next = life.buckets[b];
+            life.buckets[b] = i;
+            life.liveNodes++;
+        }
+        else {
+            node.level = -1;
+            node.next = life.freeList;
+            life.freeList = i;
+        }
+    }
+}
+
+/*
+ * Adds the live cells of node n, whose upper left cell is (row, col)
+ * within the root, to cells.
+ */
+
+static void CollectCells(hashLifeT &life, int n, int64_t row, int64_t col, std::vector<std::pair<int64_t, int64_t> > &cells) {
+    hashNodeT node = life.nodes[n];
+    if (node.population == 0) return;
+    if (node.level == 0) {
+        cells.push_back(std::make_pair(row, col));
+        return;
+    }
+    int64_t half = int64_t(1) << (node.level - 1);
+    CollectCells(life, node.nw, row, col, cells);
+    CollectCells(life, node.ne, row, col + half, cells);
+    CollectCells(life, node.sw, row + half, col, cells);
+    CollectCells(life, node.se, row + half, col + half, cells);
+}
@@ -0,0 +1,102 @@
+//
+//  lifeHash.h
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+/*
+ * Defines the HashLife engine, for runs far too long to step one
+ * generation at a time.
+ *
+ * The universe is a quadtree of square nodes.  Every node is canonical:
+ * two regions with the same cells are the same node, found through a
+ * hash table, and each node remembers its own future.  Repeated structure
+ * in space and time is then computed once, and a pattern can be advanced
+ * by 2^k generations in one call.  The node cache is garbage collected
+ * when it grows past a limit.
+ *
+ * HashLife runs on an unbounded plane, so the simMode edges do not apply,
+ * and it does not track ages: live cells come out with age 1.
+ *
+ */
+
+#ifndef life_lifeHash_h
+#define life_lifeHash_h
+
+#include <stdint.h>
+#include <vector>
+
+#include "grid.h"
+#include "lifeGrid.h"
+#include "lifeSparse.h"
+
+struct hashNodeT {
+    int nw, ne, sw, se;     // quadrants, or -1 for the two leaf cells
+    int level;              // the node is 2^level cells on a side
+    double population;
+    int result;             // center after 2^(level-2) generations, or -1
+    int stepResult;         // center after 2^stepLog generations, or -1
+    int stepLog;
+    int next;               // next node in the hash bucket or free list
+    bool marked;
+};
+
+struct hashLifeT {
+    std::vector<hashNodeT> nodes;
+    std::vector<int> buckets;
+    std::vector<int> empties;   // the empty node of each level
+    int freeList;
+    int liveNodes;
+    int maxNodes;               // collect garbage beyond this many nodes
+    int root;
+    int64_t originRow;          // where the root's upper left cell sits
+    int64_t originCol;          // relative to cell (0, 0) of the window
+    int64_t generation;
+};
+
+/*
+ * Builds a universe holding the live cells of gridLife, which becomes
+ * the window exported by HashLifeToGrid.
+ */
+
+void InitHashLife(hashLifeT &life, gridLifeT &gridLife);
+
+/*
+ * Advances the universe by 2^stepLog generations.  Returns true if the
+ * pattern is exactly the same as before the step.
+ */
+
+bool StepHashLife(hashLifeT &life, int stepLog);
+
+/*
+ * Returns the period of a pattern that StepHashLife has just found the
+ * same after 2^stepLog generations: 1 for a still life, otherwise the
+ * shortest oscillation, which divides 2^stepLog.
+ */
+
+int64_t HashLifePeriod(hashLifeT &life, int stepLog);
+
+/*
+ * Copies the cells of the window into gridLife (age 1 for live cells).
+ */
+
+void HashLifeToGrid(hashLifeT &life, gridLifeT &gridLife);
+
+/*
+ * Copies every live cell of the universe, wherever it has gone, into
+ * sparse, with the upper left corner of their bounding box at (0, 0) and
+ * the window set to that box.  Returns false if the box is too large for
+ * int coordinates.
+ */
+
+bool HashLifeToSparse(hashLifeT &life, sparseLifeT &sparse);
+
+/*
+ * Returns the number of live cells in the universe.
+ */
+
+double HashLifePopulation(hashLifeT &life);
+
+#endif
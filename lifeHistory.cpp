@@ -0,0 +1,184 @@
+//
+//  lifeHistory.cpp
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+#include "genlib.h"
+#include "grid.h"
+
+#include "lifeHistory.h"
+#include "lifeGraphics.h"
+
+static void StartSpan(historyT &history, int64_t generation);
+static void Forget(historyT &history);
+
+static void PackAges(gridLifeT &gridLife, std::vector<unsigned char> &ages) {
+    int nCols = gridLife.numCols();
+    ages.resize((size_t) gridLife.numRows() * nCols);
+    for (int i = 0; i < gridLife.numRows(); i++) {
+        for (int j = 0; j < nCols; j++) {
+            int age = gridLife[i][j];
+            ages[(size_t) i * nCols + j] = (age < MaxAge) ? age : MaxAge;
+        }
+    }
+}
+
+void InitHistory(historyT &history, gridLifeT &gridLife, int64_t generation,
+                 size_t budget, int keyframeEvery) {
+    history.nRows = gridLife.numRows();
+    history.nCols = gridLife.numCols();
+    history.keyframeEvery = (keyframeEvery > 0) ? keyframeEvery : 1;
+    history.budget = budget;
+    history.bytes = 0;
+    history.spans.clear();
+    PackAges(gridLife, history.newest);
+    history.newestGeneration = generation;
+    StartSpan(history, generation);
+}
+
+static void StartSpan(historyT &history, int64_t generation) {
+    history.spans.push_back(historySpanT());
+    historySpanT &span = history.spans.back();
+    span.generation = generation;
+    span.nChanges = 0;
+    span.ages = history.newest;
+    history.bytes += span.ages.size();
+}
+
+/*
+ * Returns the age a cell of the given age has next generation if it
+ * stays alive, or stays dead.
+ */
+
+static inline int Aged(int age) {
+    return (age > 0 && age < MaxAge) ? age + 1 : age;
+}
+
+/*
+ * Each changed cell is written as the gap from the previous one (from -1
+ * at the start of each generation), seven bits to a byte with the high
+ * bit set on all but the last, followed by its new age.  Gaps are never
+ * 0, so a 0 byte ends the generation.
+ */
+
+static void PutGap(std::vector<unsigned char> &changes, size_t gap) {
+    while (gap >= 0x80) {
+        changes.push_back((gap & 0x7f) | 0x80);
+        gap >>= 7;
+    }
+    changes.push_back(gap);
+}
+
+static size_t GetGap(const unsigned char *&p) {
+    size_t gap = 0;
+    int shift = 0;
+    while (*p & 0x80) {
+        gap |= size_t(*p++ & 0x7f) << shift;
+        shift += 7;
+    }
+    gap |= size_t(*p++) << shift;
+    return gap;
+}
+
+void RecordGeneration(historyT &history, gridLifeT &gridLife, int64_t generation) {
+    std::vector<unsigned char> &newest = history.newest;
+    if (generation != history.newestGeneration + 1
+        || history.spans.back().nChanges + 1 >= history.keyframeEvery) {
+        PackAges(gridLife, newest);
+        history.newestGeneration = generation;
+        StartSpan(history, generation);
+        Forget(history);
+        return;
+    }
+    historySpanT &span = history.spans.back();
+    size_t before = span.changes.capacity();
+    size_t last = (size_t) -1;
+    int nCols = history.nCols;
+    for (int i = 0; i < history.nRows; i++) {
+        for (int j = 0; j < nCols; j++) {
+            size_t index = (size_t) i * nCols + j;
+            int age = (gridLife[i][j] < MaxAge) ? gridLife[i][j] : MaxAge;
+            if (age != Aged(newest[index])) {
+                PutGap(span.changes, index - last);
+                span.changes.push_back(age);
+                last = index;
+            }
+            newest[index] = age;
+        }
+    }
+    span.changes.push_back(0);
+    span.nChanges++;
+    history.newestGeneration = generation;
+    history.bytes += span.changes.capacity() - before;
+    Forget(history);
+}
+
+/*
+ * Drops the oldest spans until the history fits its budget, always
+ * keeping the newest.
+ */
+
+static void Forget(historyT &history) {
+    while (history.bytes > history.budget && history.spans.size() > 1) {
+        historySpanT &oldest = history.spans.front();
+        history.bytes -= oldest.ages.size() + oldest.changes.capacity();
+        history.spans.pop_front();
+    }
+}
+
+int64_t HistoryFirst(historyT &history) {
+    return history.spans.front().generation;
+}
+
+int64_t HistoryLast(historyT &history) {
+    return history.newestGeneration;
+}
+
+/*
+ * Replays one generation's changes: every live cell ages, then the cells
+ * listed take their new ages.
+ */
+
+static void ReplayGeneration(std::vector<unsigned char> &ages, const unsigned char *&p) {
+    for (size_t k = 0; k < ages.size(); k++) {
+        ages[k] = Aged(ages[k]);
+    }
+    size_t index = (size_t) -1;
+    while (*p != 0) {
+        index += GetGap(p);
+        ages[index] = *p++;
+    }
+    p++;
+}
+
+bool SeekHistory(historyT &history, int64_t generation, gridLifeT &gridLife) {
+    if (generation < HistoryFirst(history) || generation > HistoryLast(history)) {
+        return false;
+    }
+    // Binary search for the last span starting at or before generation
+    int lo = 0, hi = (int) history.spans.size() - 1;
+    while (lo < hi) {
+        int mid = (lo + hi + 1) / 2;
+        if (history.spans[mid].generation <= generation) lo = mid;
+        else hi = mid - 1;
+    }
+    historySpanT &span = history.spans[lo];
+    if (generation > span.generation + span.nChanges) {
+        return false;   // skipped over by a multi-generation step
+    }
+    std::vector<unsigned char> ages = span.ages;
+    const unsigned char *p = span.changes.empty() ? NULL : &span.changes[0];
+    for (int64_t g = span.generation; g < generation; g++) {
+        ReplayGeneration(ages, p);
+    }
+    gridLife.resize(history.nRows, history.nCols);
+    for (int i = 0; i < history.nRows; i++) {
+        for (int j = 0; j < history.nCols; j++) {
+            gridLife[i][j] = ages[(size_t) i * history.nCols + j];
+        }
+    }
+    return true;
+}
@@ -0,0 +1,95 @@
+//
+//  lifeHistory.h
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+/*
+ * Keeps the generations of a run so it can be stepped back through and
+ * revisited.
+ *
+ * Every so many generations a keyframe holding the age of every cell is
+ * stored.  In between, a generation is stored as a list of just the cells
+ * that did not simply age: a cell alive in both generations is normally
+ * one generation older (up to MaxAge), so only births, deaths and the odd
+ * cell arriving from off the window are listed, each as the gap from the
+ * cell listed before it in a variable-length byte code plus its new age.
+ * Seeking replays the change lists forward from the nearest keyframe at
+ * or before the generation wanted, so it costs at most keyframeEvery
+ * generations of replay however long the run.
+ *
+ * The store stays within a memory budget by forgetting the oldest
+ * keyframe, and the generations recorded after it, whenever it would
+ * grow past the budget.
+ *
+ */
+
+#ifndef life_lifeHistory_h
+#define life_lifeHistory_h
+
+#include <stdint.h>
+#include <deque>
+#include <vector>
+
+#include "genlib.h"
+#include "grid.h"
+#include "lifeGrid.h"
+
+/*
+ * Type: historySpanT
+ * ------------------
+ * A keyframe and the generations recorded after it.  Generations are
+ * consecutive within a span; a gap in the generations recorded (as when
+ * HashLife steps many at once) starts a new span.
+ */
+
+struct historySpanT {
+    int64_t generation;                 // generation of the keyframe
+    int64_t nChanges;                   // generations recorded after it
+    std::vector<unsigned char> ages;    // the keyframe, one age per cell
+    std::vector<unsigned char> changes; // each generation's cells, 0 ended
+};
+
+struct historyT {
+    int nRows;
+    int nCols;
+    int keyframeEvery;                  // generations between keyframes
+    size_t budget;                      // bytes the spans may take
+    size_t bytes;                       // bytes the spans take now
+    std::deque<historySpanT> spans;
+    std::vector<unsigned char> newest;  // ages of the last generation recorded
+    int64_t newestGeneration;
+};
+
+/*
+ * Starts the history of a run with gridLife, the grid of ages at the given
+ * generation.
+ */
+
+void InitHistory(historyT &history, gridLifeT &gridLife, int64_t generation,
+                 size_t budget, int keyframeEvery = 64);
+
+/*
+ * Records gridLife as the given generation, which must come after the last
+ * one recorded.
+ */
+
+void RecordGeneration(historyT &history, gridLifeT &gridLife, int64_t generation);
+
+/*
+ * The oldest and newest generations the history still holds.
+ */
+
+int64_t HistoryFirst(historyT &history);
+int64_t HistoryLast(historyT &history);
+
+/*
+ * Fills gridLife with the ages of the given generation.  Returns false if
+ * the history no longer (or never) held it.
+ */
+
+bool SeekHistory(historyT &history, int64_t generation, gridLifeT &gridLife);
+
+#endif
@@ -0,0 +1,191 @@
+//
+//  lifeKernel.cpp
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+#include "lifeKernel.h"
+#include "lifeGraphics.h"
+
+/*
+ * The vector kernels are compiled with per-function target attributes
+ * and chosen at run time, so the file itself is built for the baseline
+ * processor.  Compilers too old for that get only the scalar kernel.
+ */
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__clang__) || __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define LIFE_SIMD 1
+#include <immintrin.h>
+#else
+#define LIFE_SIMD 0
+#endif
+
+/*
+ * Ages a cell by one generation given its live neighbor count:
+ * 3 neighbors gives birth or survival, 2 lets a live cell survive,
+ * anything else dies.  Survivors age up to MaxAge.
+ */
+
+static inline int NextAge(int age, int neighbors) {
+    int lives = (neighbors == 3) | ((neighbors == 2) & (age > 0));
+    int older = age + (age < MaxAge);
+    return lives ? older : 0;
+}
+
+static inline int IsYoung(int age) {
+    return (unsigned) (age - 1) < (unsigned) (MaxAge - 1);   // 0 < age < MaxAge
+}
+
+/*
+ * Finishes cells [from, n) of a row one at a time.  The vector kernels
+ * use this for the cells left over after the last full vector.
+ */
+
+static int ScalarTail(const cellT *up, const cellT *mid, const cellT *down, cellT *out, int from, int n) {
+    int young = 0;
+    for (int j = from; j < n; j++) {
+        int neighbors = (up[j - 1] > 0) + (up[j] > 0) + (up[j + 1] > 0)
+                      + (mid[j - 1] > 0) + (mid[j + 1] > 0)
+                      + (down[j - 1] > 0) + (down[j] > 0) + (down[j + 1] > 0);
+        out[j] = NextAge(mid[j], neighbors);
+        young |= IsYoung(out[j]);
+    }
+    return young;
+}
+
+static int ScalarRow(const cellT *up, const cellT *mid, const cellT *down, cellT *out, int n) {
+    return ScalarTail(up, mid, down, out, 0, n);
+}
+
+#if LIFE_SIMD
+
+/*
+ * The vector kernels all follow ScalarTail step for step.  Clamping each
+ * age to 1 with an unsigned min turns it into a 0/1 liveness value, so the
+ * eight neighbors can simply be added bytewise.
+ */
+
+__attribute__((target("sse2")))
+static int Sse2Row(const cellT *up, const cellT *mid, const cellT *down, cellT *out, int n) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i two = _mm_set1_epi8(2);
+    const __m128i three = _mm_set1_epi8(3);
+    const __m128i maxAge = _mm_set1_epi8(MaxAge);
+    __m128i young = zero;
+    int j = 0;
+    for (; j + 16 <= n; j += 16) {
+#define LIVE(p) _mm_min_epu8(_mm_loadu_si128((const __m128i *) (p)), one)
+        __m128i sum = _mm_add_epi8(_mm_add_epi8(LIVE(up + j - 1), LIVE(up + j)),
+                                   _mm_add_epi8(LIVE(up + j + 1), LIVE(mid + j - 1)));
+        sum = _mm_add_epi8(sum, _mm_add_epi8(_mm_add_epi8(LIVE(mid + j + 1), LIVE(down + j - 1)),
+                                             _mm_add_epi8(LIVE(down + j), LIVE(down + j + 1))));
+#undef LIVE
+        __m128i age = _mm_loadu_si128((const __m128i *) (mid + j));
+        __m128i dead = _mm_cmpeq_epi8(age, zero);
+        __m128i lives = _mm_or_si128(_mm_cmpeq_epi8(sum, three),
+                                     _mm_andnot_si128(dead, _mm_cmpeq_epi8(sum, two)));
+        __m128i older = _mm_min_epu8(_mm_adds_epu8(age, one), maxAge);
+        __m128i next = _mm_and_si128(lives, older);
+        _mm_storeu_si128((__m128i *) (out + j), next);
+        young = _mm_or_si128(young, _mm_andnot_si128(_mm_or_si128(_mm_cmpeq_epi8(next, zero),
+                                                                  _mm_cmpeq_epi8(next, maxAge)),
+                                                     _mm_cmpeq_epi8(zero, zero)));
+    }
+    return (_mm_movemask_epi8(young) != 0) | ScalarTail(up, mid, down, out, j, n);
+}
+
+__attribute__((target("avx2")))
+static int Avx2Row(const cellT *up, const cellT *mid, const cellT *down, cellT *out, int n) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi8(1);
+    const __m256i two = _mm256_set1_epi8(2);
+    const __m256i three = _mm256_set1_epi8(3);
+    const __m256i maxAge = _mm256_set1_epi8(MaxAge);
+    __m256i young = zero;
+    int j = 0;
+    for (; j + 32 <= n; j += 32) {
+#define LIVE(p) _mm256_min_epu8(_mm256_loadu_si256((const __m256i *) (p)), one)
+        __m256i sum = _mm256_add_epi8(_mm256_add_epi8(LIVE(up + j - 1), LIVE(up + j)),
+                                      _mm256_add_epi8(LIVE(up + j + 1), LIVE(mid + j - 1)));
+        sum = _mm256_add_epi8(sum, _mm256_add_epi8(_mm256_add_epi8(LIVE(mid + j + 1), LIVE(down + j - 1)),
+                                                   _mm256_add_epi8(LIVE(down + j), LIVE(down + j + 1))));
+#undef LIVE
+        __m256i age = _mm256_loadu_si256((const __m256i *) (mid + j));
+        __m256i dead = _mm256_cmpeq_epi8(age, zero);
+        __m256i lives = _mm256_or_si256(_mm256_cmpeq_epi8(sum, three),
+                                        _mm256_andnot_si256(dead, _mm256_cmpeq_epi8(sum, two)));
+        __m256i older = _mm256_min_epu8(_mm256_adds_epu8(age, one), maxAge);
+        __m256i next = _mm256_and_si256(lives, older);
+        _mm256_storeu_si256((__m256i *) (out + j), next);
+        young = _mm256_or_si256(young, _mm256_andnot_si256(_mm256_or_si256(_mm256_cmpeq_epi8(next, zero),
+                                                                           _mm256_cmpeq_epi8(next, maxAge)),
+                                                           _mm256_cmpeq_epi8(zero, zero)));
+    }
+    return (_mm256_movemask_epi8(young) != 0) | ScalarTail(up, mid, down, out, j, n);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static int Avx512Row(const cellT *up, const cellT *mid, const cellT *down, cellT *out, int n) {
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i one = _mm512_set1_epi8(1);
+    const __m512i two = _mm512_set1_epi8(2);
+    const __m512i three = _mm512_set1_epi8(3);
+    const __m512i maxAge = _mm512_set1_epi8(MaxAge);
+    __mmask64 young = 0;
+    int j = 0;
+    for (; j + 64 <= n; j += 64) {
+#define LIVE(p) _mm512_min_epu8(_mm512_loadu_si512((const void *) (p)), one)
+        __m512i sum = _mm512_add_epi8(_mm512_add_epi8(LIVE(up + j - 1), LIVE(up + j)),
+                                      _mm512_add_epi8(LIVE(up + j + 1), LIVE(mid + j - 1)));
+        sum = _mm512_add_epi8(sum, _mm512_add_epi8(_mm512_add_epi8(LIVE(mid + j + 1), LIVE(down + j - 1)),
+                                                   _mm512_add_epi8(LIVE(down + j), LIVE(down + j + 1))));
+#undef LIVE
+        __m512i age = _mm512_loadu_si512((const void *) (mid + j));
+        __mmask64 lives = _mm512_cmpeq_epi8_mask(sum, three)
+                        | (_mm512_cmpeq_epi8_mask(sum, two) & _mm512_cmpneq_epi8_mask(age, zero));
+        __m512i older = _mm512_min_epu8(_mm512_adds_epu8(age, one), maxAge);
+        __m512i next = _mm512_maskz_mov_epi8(lives, older);
+        _mm512_storeu_si512((void *) (out + j), next);
+        young |= _mm512_cmpneq_epi8_mask(next, zero) & _mm512_cmpneq_epi8_mask(next, maxAge);
+    }
+    return (young != 0) | ScalarTail(up, mid, down, out, j, n);
+}
+
+#endif
+
+simdLevelT BestSimdLevel() {
+#if LIFE_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512bw")) return Avx512Level;
+    if (__builtin_cpu_supports("avx2")) return Avx2Level;
+    if (__builtin_cpu_supports("sse2")) return Sse2Level;
+#endif
+    return ScalarLevel;
+}
+
+rowKernelT RowKernelFor(simdLevelT level) {
+#if LIFE_SIMD
+    simdLevelT best = BestSimdLevel();
+    if (level > best) level = best;
+    switch (level) {
+        case Avx512Level: return Avx512Row;
+        case Avx2Level: return Avx2Row;
+        case Sse2Level: return Sse2Row;
+        default: break;
+    }
+#endif
+    return ScalarRow;
+}
+
+std::string SimdLevelName(simdLevelT level) {
+    switch (level) {
+        case Sse2Level: return "sse2";
+        case Avx2Level: return "avx2";
+        case Avx512Level: return "avx512";
+        default: return "scalar";
+    }
+}
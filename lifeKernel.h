@@ -0,0 +1,63 @@
+//
+//  lifeKernel.h
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+/*
+ * Defines the row kernels the standard engine steps with.  A row kernel
+ * computes the next age of every cell in one board row from the rows
+ * above, at and below it, on planes of one byte per cell.
+ *
+ * Besides the plain scalar kernel there are SSE2, AVX2 and AVX-512
+ * versions that handle 16, 32 and 64 cells at a time.  The best one the
+ * processor supports is picked at startup from cpuid, so one build runs
+ * well on any x86 machine.  Every kernel gives exactly the same results.
+ *
+ */
+
+#ifndef life_lifeKernel_h
+#define life_lifeKernel_h
+
+#include <string>
+
+typedef unsigned char cellT;
+
+/*
+ * Type: rowKernelT
+ * ----------------
+ * Computes out[0..n-1] from the three rows up, mid and down, each of which
+ * must be readable from index -1 to n.  Returns nonzero if any cell in out
+ * is alive but younger than MaxAge.
+ */
+
+typedef int (*rowKernelT)(const cellT *up, const cellT *mid, const cellT *down, cellT *out, int n);
+
+enum simdLevelT {
+    ScalarLevel,
+    Sse2Level,
+    Avx2Level,
+    Avx512Level
+};
+
+/*
+ * Returns the widest kernel level this processor (and build) supports.
+ */
+
+simdLevelT BestSimdLevel();
+
+/*
+ * Returns the row kernel for level, or the best supported one below it.
+ */
+
+rowKernelT RowKernelFor(simdLevelT level);
+
+/*
+ * Returns a printable name for level, e.g. "avx2".
+ */
+
+std::string SimdLevelName(simdLevelT level);
+
+#endif
@@ -0,0 +1,92 @@
+//
+//  lifeLatency.cpp
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+#include <cstdio>
+#include <cstring>
+
+#include "genlib.h"
+
+#include "lifeLatency.h"
+
+const int SubBuckets = 1 << LatencySubBits;
+
+/*
+ * Times below SubBuckets nanoseconds get a bucket each.  Above that, a
+ * time whose top bit is bit (LatencySubBits + shift) lands in block
+ * shift + 1, at the bucket given by its next LatencySubBits bits.
+ */
+
+static int BucketOf(int64_t nanos) {
+    if (nanos < SubBuckets) return (nanos < 0) ? 0 : (int) nanos;
+    int shift = 63 - __builtin_clzll((unsigned long long) nanos) - LatencySubBits;
+    int bucket = ((shift + 1) << LatencySubBits) + (int) ((nanos >> shift) - SubBuckets);
+    return (bucket < LatencyBuckets) ? bucket : LatencyBuckets - 1;
+}
+
+static int64_t BucketTop(int bucket) {
+    if (bucket < SubBuckets) return bucket;
+    int shift = (bucket >> LatencySubBits) - 1;
+    int64_t first = int64_t(SubBuckets + (bucket & (SubBuckets - 1))) << shift;
+    return first + (int64_t(1) << shift) - 1;
+}
+
+void InitLatency(latencyT &latency) {
+    memset(latency.counts, 0, sizeof latency.counts);
+    latency.total = 0;
+    latency.sum = 0;
+    latency.longest = 0;
+}
+
+void RecordLatency(latencyT &latency, int64_t nanos) {
+    latency.counts[BucketOf(nanos)]++;
+    latency.total++;
+    latency.sum += nanos;
+    if (nanos > latency.longest) latency.longest = nanos;
+}
+
+int64_t LatencyPercentile(latencyT &latency, double fraction) {
+    if (latency.total == 0) return 0;
+    int64_t wanted = (int64_t) (fraction * latency.total + 0.5);
+    if (wanted < 1) wanted = 1;
+    int64_t seen = 0;
+    for (int k = 0; k < LatencyBuckets; k++) {
+        seen += latency.counts[k];
+        if (seen >= wanted) {
+            int64_t top = BucketTop(k);
+            return (top < latency.longest) ? top : latency.longest;
+        }
+    }
+    return latency.longest;
+}
+
+/*
+ * Formats a time with three significant digits in a fitting unit.
+ */
+
+static string Duration(double nanos) {
+    static const char *units[] = { "ns", "us", "ms", "s" };
+    int unit = 0;
+    while (nanos >= 1000 && unit < 3) {
+        nanos /= 1000;
+        unit++;
+    }
+    char text[32];
+    sprintf(text, (nanos < 10) ? "%.2f %s" : (nanos < 100) ? "%.1f %s" : "%.0f %s", nanos, units[unit]);
+    return text;
+}
+
+void PrintLatency(ostream &out, string name, latencyT &latency) {
+    char line[256];
+    double mean = latency.total ? double(latency.sum) / latency.total : 0;
+    sprintf(line, "%-6s n %-8lld mean %-9s p50 %-9s p90 %-9s p99 %-9s p99.9 %-9s max %s", name.c_str(),
+            (long long) latency.total, Duration(mean).c_str(),
+            Duration(LatencyPercentile(latency, 0.5)).c_str(), Duration(LatencyPercentile(latency, 0.9)).c_str(),
+            Duration(LatencyPercentile(latency, 0.99)).c_str(), Duration(LatencyPercentile(latency, 0.999)).c_str(),
+            Duration(latency.longest).c_str());
+    out << line << endl;
+}
@@ -0,0 +1,62 @@
+//
+//  lifeLatency.h
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+/*
+ * Defines a histogram of latencies, for following how long generations
+ * take to step, draw and show, and above all how long the slowest ones
+ * take, which an average hides.
+ *
+ * Buckets are log-linear, as in an HDR histogram: every power of two is
+ * split into 2^LatencySubBits equal buckets, so any time from a
+ * nanosecond to hours is kept to within about 3%, in a fixed array that
+ * recording never allocates or searches.
+ *
+ */
+
+#ifndef life_lifeLatency_h
+#define life_lifeLatency_h
+
+#include <stdint.h>
+#include <iostream>
+
+#include "genlib.h"
+
+const int LatencySubBits = 5;
+const int LatencyBuckets = (64 - LatencySubBits) << LatencySubBits;
+
+struct latencyT {
+    int64_t counts[LatencyBuckets];
+    int64_t total;          // times recorded
+    int64_t sum;            // nanoseconds
+    int64_t longest;
+};
+
+void InitLatency(latencyT &latency);
+
+/*
+ * Adds one time, in nanoseconds, to the histogram.
+ */
+
+void RecordLatency(latencyT &latency, int64_t nanos);
+
+/*
+ * Returns the time that fraction of the recorded times (0.5 for the
+ * median, 0.99 for p99) are no longer than, rounded up to the top of its
+ * bucket, or 0 if nothing was recorded.
+ */
+
+int64_t LatencyPercentile(latencyT &latency, double fraction);
+
+/*
+ * Prints one line for the histogram, headed by name: the count, mean,
+ * p50, p90, p99, p99.9 and longest times.
+ */
+
+void PrintLatency(ostream &out, string name, latencyT &latency);
+
+#endif
@@ -0,0 +1,120 @@
+//
+//  lifeMap.cpp
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+#include <cctype>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "genlib.h"
+#include "strutils.h"
+
+#include "lifeMap.h"
+#include "lifeTrace.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/*
+ * Packs the first n bytes of a row into words, one bit per byte, set
+ * where the byte is 'X'.  With SSE2, 16 bytes are compared at once and
+ * their results gathered into 16 bits with a single movemask.
+ */
+
+static void ClassifyRow(const char *row, int n, bitWordT *words) {
+    int j = 0;
+#ifdef __SSE2__
+    const __m128i live = _mm_set1_epi8('X');
+    for (; j + BitsPerWord <= n; j += BitsPerWord) {
+        bitWordT word = 0;
+        for (int k = 0; k < BitsPerWord; k += 16) {
+            __m128i bytes = _mm_loadu_si128((const __m128i *) (row + j + k));
+            unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, live));
+            word |= bitWordT(mask) << k;
+        }
+        words[j / BitsPerWord] = word;
+    }
+#endif
+    for (; j < n; j++) {
+        if (row[j] == 'X') {
+            words[j / BitsPerWord] |= bitWordT(1) << (j % BitsPerWord);
+        }
+    }
+}
+
+bool MapGridFileBits(string filename, bitGridT &bits, int simMode) {
+    TRACE_SCOPE(LoadPhase);
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return false;
+    }
+    size_t size = info.st_size;
+    ResizeBitGrid(bits, 0, 0, simMode);
+    if (size == 0) {
+        close(fd);
+        return true;
+    }
+    void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return false;
+    madvise(map, size, MADV_SEQUENTIAL);
+
+    const char *p = (const char *) map;
+    const char *end = p + size;
+    int nRows = 0;
+    bool gotRow = false;
+    int currentRow = 0;
+    while (p < end) {
+        const char *eol = (const char *) memchr(p, '\n', end - p);
+        if (eol == NULL) eol = end;
+        int length = eol - p;
+        char first = (length > 0) ? p[0] : '\0';
+        bool negative = (first == '-' && length > 1 && isdigit((unsigned char) p[1]));
+        if ((first == 'X' || first == '-') && !negative) { // Parse for Grid
+            if (currentRow >= bits.nRows) {
+                munmap(map, size);
+                Error("Pattern file " + filename + " has more rows than its header gives");
+            }
+            int n = (length < bits.nCols) ? length : bits.nCols;
+            ClassifyRow(p, n, BitRow(bits, currentRow));
+            currentRow += 1;
+        }
+        else if (first == '#') { // Ignore comments
+
+        }
+        else { // A row or column count, as in GetGridFromFile
+            int param = StringToInteger(string(p, length));
+            if (param <= 0) {
+                munmap(map, size);
+                Error("Pattern file " + filename + " gives " + IntegerToString(param)
+                      + (gotRow ? " columns" : " rows") + "; a grid needs at least one of each");
+            }
+            if (gotRow) {
+                if ((long long) nRows * param > MaxPatternCells) {
+                    munmap(map, size);
+                    Error("Pattern file " + filename + " is too large to load: " + IntegerToString(nRows)
+                          + " rows by " + IntegerToString(param) + " columns");
+                }
+                ResizeBitGrid(bits, nRows, param, simMode);
+            }
+            else {
+                nRows = param;
+                gotRow = true;
+            }
+        }
+        p = eol + 1;
+    }
+    munmap(map, size);
+    return true;
+}
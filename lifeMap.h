@@ -0,0 +1,37 @@
+//
+//  lifeMap.h
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+/*
+ * Defines a loader for very large plaintext pattern files.  The file is
+ * memory-mapped and each row is classified where it lies, sixteen bytes
+ * at a time, straight into the bit-packed engine's words.  No line is
+ * copied into a string and no grid of ages is built, so loading runs at
+ * about the speed the file can be read.
+ *
+ * The format is the one GetGridFromFile reads, handled the same way:
+ * lines starting with '#' are comments, lines starting with 'X' or '-'
+ * are rows, and any other line is a number, the first giving the rows
+ * and the second the columns.  Only 'X' is alive; a short row is padded
+ * with dead cells and a long one is cut off.
+ *
+ */
+
+#ifndef life_lifeMap_h
+#define life_lifeMap_h
+
+#include "genlib.h"
+#include "lifeBits.h"
+
+/*
+ * Loads the named plaintext pattern file into bits, ready to step in the
+ * given simMode.  Returns false if the file cannot be opened or mapped.
+ */
+
+bool MapGridFileBits(string filename, bitGridT &bits, int simMode);
+
+#endif
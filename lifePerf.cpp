@@ -0,0 +1,164 @@
+//
+//  lifePerf.cpp
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#endif
+
+#include "genlib.h"
+
+#include "lifePerf.h"
+
+/*
+ * A group read returns the number of counters, the times the group was
+ * enabled and actually running, then one value per counter.
+ */
+
+const int GroupHeader = 3;
+
+#ifdef __linux__
+
+static void EventConfig(perfEventT event, struct perf_event_attr &attr) {
+    switch (event) {
+        case CyclesEvent:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case InstructionsEvent:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case L1MissEvent:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                          (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            break;
+        case LlcMissEvent:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+            break;
+        default:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+    }
+}
+
+static int OpenEvent(perfEventT event, int leader) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof attr);
+    attr.size = sizeof attr;
+    EventConfig(event, attr);
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int) syscall(__NR_perf_event_open, &attr, 0, -1, leader, 0);
+}
+
+#endif
+
+bool OpenPerfCounters(perfCountersT &counters) {
+    counters.leader = -1;
+    counters.nOpen = 0;
+    for (int k = 0; k < NumPerfEvents; k++) {
+        counters.fds[k] = -1;
+        counters.slot[k] = -1;
+    }
+#ifdef __linux__
+    for (int k = 0; k < NumPerfEvents; k++) {
+        int fd = OpenEvent(perfEventT(k), counters.leader);
+        if (fd < 0) continue;
+        if (counters.leader < 0) counters.leader = fd;
+        counters.fds[k] = fd;
+        counters.slot[k] = counters.nOpen++;
+    }
+#endif
+    return counters.leader >= 0;
+}
+
+void ClosePerfCounters(perfCountersT &counters) {
+    for (int k = 0; k < NumPerfEvents; k++) {
+        if (counters.fds[k] >= 0) close(counters.fds[k]);
+        counters.fds[k] = -1;
+    }
+    counters.leader = -1;
+    counters.nOpen = 0;
+}
+
+void InitPerfTotals(perfTotalsT &totals) {
+    for (int k = 0; k < NumPerfEvents; k++) {
+        totals.counts[k] = 0;
+    }
+    totals.calls = 0;
+    totals.cells = 0;
+}
+
+static bool ReadGroup(perfCountersT &counters, uint64_t values[]) {
+    ssize_t wanted = (GroupHeader + counters.nOpen) * sizeof(uint64_t);
+    return counters.leader >= 0 && read(counters.leader, values, wanted) == wanted;
+}
+
+void BeginPerf(perfCountersT &counters) {
+    uint64_t values[GroupHeader + NumPerfEvents];
+    if (!ReadGroup(counters, values)) return;
+    counters.startEnabled = values[1];
+    counters.startRunning = values[2];
+    for (int k = 0; k < counters.nOpen; k++) {
+        counters.start[k] = values[GroupHeader + k];
+    }
+}
+
+/*
+ * If other users of the counters crowded the group out for part of the
+ * call, the counts are scaled up by the share of time it was not running.
+ */
+
+void EndPerf(perfCountersT &counters, perfTotalsT &totals, double cells) {
+    uint64_t values[GroupHeader + NumPerfEvents];
+    if (!ReadGroup(counters, values)) return;
+    uint64_t enabled = values[1] - counters.startEnabled;
+    uint64_t running = values[2] - counters.startRunning;
+    if (running == 0) return;
+    double scale = double(enabled) / running;
+    for (int k = 0; k < NumPerfEvents; k++) {
+        int slot = counters.slot[k];
+        if (slot >= 0) {
+            totals.counts[k] += (values[GroupHeader + slot] - counters.start[slot]) * scale;
+        }
+    }
+    totals.calls++;
+    totals.cells += cells;
+}
+
+static string PerCell(perfCountersT &counters, perfTotalsT &totals, perfEventT event) {
+    if (counters.slot[event] < 0 || totals.cells == 0) return "n/a";
+    char text[32];
+    sprintf(text, "%.4f", totals.counts[event] / totals.cells);
+    return text;
+}
+
+void PrintPerf(ostream &out, string name, perfCountersT &counters, perfTotalsT &totals) {
+    string ipc = "n/a";
+    if (counters.slot[CyclesEvent] >= 0 && counters.slot[InstructionsEvent] >= 0 && totals.counts[CyclesEvent] > 0) {
+        char text[32];
+        sprintf(text, "%.2f", totals.counts[InstructionsEvent] / totals.counts[CyclesEvent]);
+        ipc = text;
+    }
+    out << name << " calls " << totals.calls
+        << "  cycles/cell " << PerCell(counters, totals, CyclesEvent)
+        << "  instructions/cell " << PerCell(counters, totals, InstructionsEvent)
+        << "  IPC " << ipc
+        << "  L1d misses/cell " << PerCell(counters, totals, L1MissEvent)
+        << "  LLC misses/cell " << PerCell(counters, totals, LlcMissEvent)
+        << "  branch misses/cell " << PerCell(counters, totals, BranchMissEvent) << endl;
+}
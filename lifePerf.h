@@ -0,0 +1,89 @@
+//
+//  lifePerf.h
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+/*
+ * Defines hardware performance counters for timing the hot paths in
+ * processor terms: cycles, instructions, L1 data and last-level cache
+ * misses and mispredicted branches, summed over every call wrapped in
+ * BeginPerf and EndPerf.  The report divides them by the cells the calls
+ * covered, which shows what a change of grid layout or stepping loop
+ * does to each cell.
+ *
+ * The counters come from perf_event_open, so they are only available on
+ * Linux, and only when the kernel lets unprivileged users count their own
+ * threads (perf_event_paranoid of 2 or less).  Elsewhere OpenPerfCounters
+ * returns false.  Counters follow the thread that opened them, so work
+ * handed to other threads is not counted.
+ *
+ */
+
+#ifndef life_lifePerf_h
+#define life_lifePerf_h
+
+#include <stdint.h>
+#include <iostream>
+
+#include "genlib.h"
+
+enum perfEventT {
+    CyclesEvent,
+    InstructionsEvent,
+    L1MissEvent,            // L1 data cache read misses
+    LlcMissEvent,           // last-level cache misses
+    BranchMissEvent,
+    NumPerfEvents
+};
+
+/*
+ * The counters of one thread, opened as a group so a single read
+ * returns them all from the same instant.
+ */
+
+struct perfCountersT {
+    int leader;                     // fd of the group leader, -1 if nothing opened
+    int fds[NumPerfEvents];         // -1 for events this processor cannot count
+    int slot[NumPerfEvents];        // place of each event in a group read
+    int nOpen;
+    uint64_t start[NumPerfEvents];  // counts at BeginPerf
+    uint64_t startEnabled;          // time the group was enabled and running,
+    uint64_t startRunning;          // for scaling when counters are shared
+};
+
+struct perfTotalsT {
+    double counts[NumPerfEvents];
+    int64_t calls;
+    double cells;           // cells the calls covered
+};
+
+/*
+ * Opens the counters for the calling thread.  Returns false if none of
+ * them can be counted here.
+ */
+
+bool OpenPerfCounters(perfCountersT &counters);
+void ClosePerfCounters(perfCountersT &counters);
+
+void InitPerfTotals(perfTotalsT &totals);
+
+/*
+ * Bracket one call: EndPerf adds what was counted since BeginPerf to
+ * totals, along with the number of cells the call covered.
+ */
+
+void BeginPerf(perfCountersT &counters);
+void EndPerf(perfCountersT &counters, perfTotalsT &totals, double cells);
+
+/*
+ * Prints one line for totals, headed by name: the calls, cycles and
+ * instructions per cell, instructions per cycle, and each kind of miss
+ * per cell.  Events that could not be counted show as n/a.
+ */
+
+void PrintPerf(ostream &out, string name, perfCountersT &counters, perfTotalsT &totals);
+
+#endif
@@ -0,0 +1,299 @@
+//
+//  lifeRle.cpp
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+#include <cstdio>
+#include <cctype>
+#include <new>
+#include <vector>
+
+#include "genlib.h"
+#include "grid.h"
+
+#include "lifeRle.h"
+
+const int RleBlockSize = 1 << 16;   // bytes read from the stream at a time
+const int RleLineLength = 70;       // the writer wraps lines at this width
+const long long RleMaxCount = 1000000000;
+
+/*
+ * The reader pulls characters from a fixed block refilled from the stream,
+ * so decoding costs one buffer check per character.
+ */
+
+struct rleReaderT {
+    istream *stream;
+    std::vector<char> block;
+    int pos;
+    int len;
+};
+
+static int NextChar(rleReaderT &reader) {
+    if (reader.pos == reader.len) {
+        reader.stream->read(&reader.block[0], RleBlockSize);
+        reader.len = (int) reader.stream->gcount();
+        reader.pos = 0;
+        if (reader.len == 0) return EOF;
+    }
+    return (unsigned char) reader.block[reader.pos++];
+}
+
+static void SkipLine(rleReaderT &reader) {
+    int c;
+    do {
+        c = NextChar(reader);
+    } while (c != '\n' && c != EOF);
+}
+
+/*
+ * Skips comments and blank lines, then reads the header line and pulls the
+ * pattern's width (x) and height (y) out of it.
+ */
+
+static bool ReadHeader(rleReaderT &reader, int &nRows, int &nCols) {
+    int c;
+    while (true) {
+        c = NextChar(reader);
+        if (c == EOF) return false;
+        if (c == '#') {
+            SkipLine(reader);
+        }
+        else if (!isspace(c)) {
+            break;
+        }
+    }
+    string header;
+    while (c != '\n' && c != EOF) {
+        header += char(c);
+        c = NextChar(reader);
+    }
+    return sscanf(header.c_str(), " x = %d , y = %d", &nCols, &nRows) == 2 && nRows >= 0 && nCols >= 0;
+}
+
+bool ReadRle(istream &input, rleSinkT &sink) {
+    rleReaderT reader;
+    reader.stream = &input;
+    reader.block.resize(RleBlockSize);
+    reader.pos = reader.len = 0;
+    int nRows, nCols;
+    if (!ReadHeader(reader, nRows, nCols)) {
+        return false;
+    }
+    if (!sink.size(sink.context, nRows, nCols)) {
+        return false;
+    }
+
+    long long row = 0, col = 0, count = 0;
+    while (true) {
+        int c = NextChar(reader);
+        if (c == EOF || c == '!') break;
+        if (isdigit(c)) {
+            count = count * 10 + (c - '0');
+            if (count > RleMaxCount) return false;
+            continue;
+        }
+        long long n = (count > 0) ? count : 1;
+        count = 0;
+        if (c == 'b' || c == '.') {
+            col += n;
+        }
+        else if (c == '$') {
+            row += n;
+            col = 0;
+        }
+        else if (isalpha(c)) { // 'o', or the state letters of multi-state rules
+            if (row < nRows && col < nCols) {
+                long long end = (col + n < nCols) ? col + n : nCols;
+                sink.run(sink.context, (int) row, (int) col, (int) (end - col));
+            }
+            col += n;
+        }
+        else if (c == '#') {
+            SkipLine(reader);
+        }
+        else if (!isspace(c)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Sinks
+ *
+ * The grid sinks allocate the header's whole rectangle, so a header naming
+ * more than MaxPatternCells cells, or one the allocator cannot satisfy, is
+ * refused rather than left to abort the program.
+ */
+
+static bool GridSize(void *context, int nRows, int nCols) {
+    gridLifeT &gridLife = *(gridLifeT *) context;
+    if ((long long) nRows * nCols > MaxPatternCells) return false;
+    try {
+        gridLife.resize(nRows, nCols);
+    }
+    catch (std::bad_alloc &) {
+        return false;
+    }
+    for (int i = 0; i < nRows; i++) {
+        for (int j = 0; j < nCols; j++) {
+            gridLife[i][j] = 0;
+        }
+    }
+    return true;
+}
+
+static void GridRun(void *context, int row, int col, int length) {
+    gridLifeT &gridLife = *(gridLifeT *) context;
+    for (int j = col; j < col + length; j++) {
+        gridLife[row][j] = 1;
+    }
+}
+
+bool ReadRleGrid(istream &input, gridLifeT &gridLife) {
+    rleSinkT sink = { GridSize, GridRun, &gridLife };
+    return ReadRle(input, sink);
+}
+
+struct bitSinkT {
+    bitGridT *bits;
+    int simMode;
+};
+
+static bool BitSize(void *context, int nRows, int nCols) {
+    bitSinkT &sink = *(bitSinkT *) context;
+    if ((long long) nRows * nCols > MaxPatternCells) return false;
+    try {
+        ResizeBitGrid(*sink.bits, nRows, nCols, sink.simMode);
+    }
+    catch (std::bad_alloc &) {
+        return false;
+    }
+    return true;
+}
+
+static void BitRun(void *context, int row, int col, int length) {
+    bitSinkT &sink = *(bitSinkT *) context;
+    SetBitRun(*sink.bits, row, col, length);
+}
+
+bool ReadRleBits(istream &input, bitGridT &bits, int simMode) {
+    bitSinkT target = { &bits, simMode };
+    rleSinkT sink = { BitSize, BitRun, &target };
+    return ReadRle(input, sink);
+}
+
+static bool SparseSize(void *context, int nRows, int nCols) {
+    sparseLifeT &life = *(sparseLifeT *) context;
+    life.nRows = nRows;
+    life.nCols = nCols;
+    life.cells.clear();
+    return true;
+}
+
+static void SparseRun(void *context, int row, int col, int length) {
+    sparseLifeT &life = *(sparseLifeT *) context;
+    sparseCellT cell;
+    cell.row = row;
+    cell.age = 1;
+    for (cell.col = col; cell.col < col + length; cell.col++) {
+        life.cells.push_back(cell);     // runs arrive in order, so the list stays sorted
+    }
+}
+
+bool ReadRleSparse(istream &input, sparseLifeT &life) {
+    rleSinkT sink = { SparseSize, SparseRun, &life };
+    return ReadRle(input, sink);
+}
+
+/*
+ * The writer is fed runs of live cells in order.  The dead cells before a
+ * run and the row ends between runs are emitted only when the next run
+ * arrives, so trailing dead cells and empty rows at the end cost nothing.
+ */
+
+struct rleWriterT {
+    ostream *out;
+    int lineLength;
+    long long row;
+    long long col;
+};
+
+static void InitRleWriter(rleWriterT &writer, ostream &out, int nRows, int nCols) {
+    writer.out = &out;
+    writer.lineLength = 0;
+    writer.row = 0;
+    writer.col = 0;
+    out << "x = " << nCols << ", y = " << nRows << ", rule = B3/S23" << endl;
+}
+
+static void PutToken(rleWriterT &writer, long long count, char tag) {
+    char token[24];
+    int length = (count == 1) ? sprintf(token, "%c", tag) : sprintf(token, "%lld%c", count, tag);
+    if (writer.lineLength + length > RleLineLength) {
+        *writer.out << '\n';
+        writer.lineLength = 0;
+    }
+    *writer.out << token;
+    writer.lineLength += length;
+}
+
+static void PutRun(rleWriterT &writer, long long row, long long col, long long length) {
+    if (row > writer.row) {
+        PutToken(writer, row - writer.row, '$');
+        writer.row = row;
+        writer.col = 0;
+    }
+    if (col > writer.col) {
+        PutToken(writer, col - writer.col, 'b');
+    }
+    PutToken(writer, length, 'o');
+    writer.col = col + length;
+}
+
+static void EndRle(rleWriterT &writer) {
+    PutToken(writer, 1, '!');
+    *writer.out << endl;
+}
+
+void WriteRle(ostream &out, gridLifeT &gridLife) {
+    rleWriterT writer;
+    InitRleWriter(writer, out, gridLife.numRows(), gridLife.numCols());
+    int nCols = gridLife.numCols();
+    for (int i = 0; i < gridLife.numRows(); i++) {
+        int j = 0;
+        while (j < nCols) {
+            if (gridLife[i][j] == 0) {
+                j++;
+                continue;
+            }
+            int start = j;
+            while (j < nCols && gridLife[i][j] > 0) j++;
+            PutRun(writer, i, start, j - start);
+        }
+    }
+    EndRle(writer);
+}
+
+void WriteRleSparse(ostream &out, sparseLifeT &life) {
+    int top = 0, left = 0, bottom = -1, right = -1;
+    SparseLifeBounds(life, top, left, bottom, right);
+    rleWriterT writer;
+    InitRleWriter(writer, out, bottom - top + 1, right - left + 1);
+    int n = (int) life.cells.size();
+    int k = 0;
+    while (k < n) {
+        int start = k;
+        while (k + 1 < n && life.cells[k + 1].row == life.cells[k].row
+               && life.cells[k + 1].col == life.cells[k].col + 1) {
+            k++;
+        }
+        k++;
+        PutRun(writer, life.cells[start].row - top, life.cells[start].col - left, k - start);
+    }
+    EndRle(writer);
+}
@@ -0,0 +1,96 @@
+//
+//  lifeRle.h
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+/*
+ * Reads and writes patterns in the run-length encoded (RLE) format used
+ * by most pattern archives:
+ *
+ *     #N Glider
+ *     x = 3, y = 3, rule = B3/S23
+ *     bob$2bo$3o!
+ *
+ * 'b' is a dead cell, 'o' a live one, '$' ends a row and '!' ends the
+ * pattern; any of them can be preceded by a repeat count.  Lines starting
+ * with '#' are comments.
+ *
+ * The reader is a streaming parser: it works through the file a block at
+ * a time and hands each run of live cells to a sink as soon as it is
+ * decoded, so no row is ever built up as a string.  Sinks are provided for
+ * a grid of ages and for the bit-packed and live-cell engines, which
+ * receive their cells directly in their own storage.
+ *
+ */
+
+#ifndef life_lifeRle_h
+#define life_lifeRle_h
+
+#include <iostream>
+
+#include "genlib.h"
+#include "grid.h"
+#include "lifeGrid.h"
+#include "lifeBits.h"
+#include "lifeSparse.h"
+
+/*
+ * Type: rleSinkT
+ * --------------
+ * Where the reader delivers a pattern.  size is called once, with the
+ * dimensions from the header line, before any calls to run, and returns
+ * false if the sink cannot hold a pattern that large; run is then called
+ * for each run of live cells, in row order and left to right.  Runs never
+ * extend past the dimensions given to size.
+ */
+
+struct rleSinkT {
+    bool (*size)(void *context, int nRows, int nCols);
+    void (*run)(void *context, int row, int col, int length);
+    void *context;
+};
+
+/*
+ * Decodes the RLE pattern from input, delivering it to sink.  Returns false if the
+ * header line is missing, the pattern is malformed or the sink refuses its size.
+ */
+
+bool ReadRle(istream &input, rleSinkT &sink);
+
+/*
+ * Reads an RLE pattern into a grid of ages.  Live cells start at age 1.
+ */
+
+bool ReadRleGrid(istream &input, gridLifeT &gridLife);
+
+/*
+ * Reads an RLE pattern straight into the bit-packed engine, ready to step
+ * in the given simMode.
+ */
+
+bool ReadRleBits(istream &input, bitGridT &bits, int simMode);
+
+/*
+ * Reads an RLE pattern straight into the live-cell engine.  The pattern's
+ * rectangle becomes the window SparseLifeToGrid exports.
+ */
+
+bool ReadRleSparse(istream &input, sparseLifeT &life);
+
+/*
+ * Writes the live cells of gridLife to out as an RLE pattern.
+ */
+
+void WriteRle(ostream &out, gridLifeT &gridLife);
+
+/*
+ * Writes the live cells of the live-cell engine to out as an RLE pattern
+ * covering their bounding box.
+ */
+
+void WriteRleSparse(ostream &out, sparseLifeT &life);
+
+#endif
@@ -0,0 +1,302 @@
+//
+//  lifeSim.cpp
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+#include <algorithm>
+
+#include "genlib.h"
+#include "grid.h"
+
+#include "lifeSim.h"
+#include "lifeTrace.h"
+
+static void StartCycle(lifeSimT &sim);
+static bool CycleHolds(lifeSimT &sim);
+static void ToggleDense(lifeSimT &sim, bool fromEmpty);
+static void ToggleBits(lifeSimT &sim, bool fromEmpty);
+
+void InitSim(lifeSimT &sim, gridLifeT &gridLife, int simMode, simEngineT engine) {
+    if (simMode == 3 && engine != HashEngine) { // Infinite
+        engine = SparseEngine;
+    }
+    sim.engine = engine;
+    sim.simMode = simMode;
+    sim.gridLife = &gridLife;
+    sim.stepLog = 0;
+    sim.generation = 0;
+    switch (engine) {
+        case BitEngine:
+            InitBitGrid(sim.bits, gridLife, simMode);
+            break;
+        case HashEngine:
+            InitHashLife(sim.hash, gridLife);
+            break;
+        case SparseEngine:
+            InitSparseLife(sim.sparse, gridLife);
+            break;
+        default:
+            InitLifeState(sim.dense, gridLife, simMode);
+            break;
+    }
+    StartCycle(sim);
+}
+
+void InitSimLoaded(lifeSimT &sim, gridLifeT &gridLife, int simMode, simEngineT engine) {
+    sim.engine = engine;
+    sim.simMode = simMode;
+    sim.gridLife = &gridLife;
+    sim.stepLog = 0;
+    sim.generation = 0;
+    StartCycle(sim);
+}
+
+/*
+ * The engines' own stabilization tests only see a colony whose every
+ * cell has reached MaxAge, so oscillators and spaceships would run
+ * forever.  Instead each step is handed to the cycle watcher.  HashLife
+ * jumps many generations at a time and keeps its own test, which only
+ * stops a colony that is the same after a whole step; its period is then
+ * worked out for the verdict.
+ */
+
+bool StepSim(lifeSimT &sim) {
+    TRACE_SCOPE(StepPhase);
+    bool engineStable = StepEngine(sim);
+    switch (sim.engine) {
+        case BitEngine:
+            ToggleBits(sim, false);
+            return CycleObserve(sim.cycle, sim.generation) && CycleHolds(sim);
+        case HashEngine:
+            if (HashLifePopulation(sim.hash) == 0) {
+                sim.cycle.kind = DiedOut;
+                return true;
+            }
+            if (engineStable) {
+                sim.cycle.period = HashLifePeriod(sim.hash, sim.stepLog);
+                sim.cycle.kind = (sim.cycle.period == 1) ? StillLife : Oscillator;
+            }
+            return engineStable;
+        case SparseEngine:
+            return CycleObserveSparse(sim.cycle, sim.sparse, sim.generation) && CycleHolds(sim);
+        default:
+            TRACE_COUNT("active tiles", sim.dense.activeTiles);
+            ToggleDense(sim, false);
+            return CycleObserve(sim.cycle, sim.generation) && CycleHolds(sim);
+    }
+}
+
+bool StepEngine(lifeSimT &sim) {
+    sim.generation += (sim.engine == HashEngine) ? int64_t(1) << sim.stepLog : 1;
+    switch (sim.engine) {
+        case BitEngine:
+            return StepBitGrid(sim.bits);
+        case HashEngine:
+            return StepHashLife(sim.hash, sim.stepLog);
+        case SparseEngine:
+            StepSparseLife(sim.sparse);
+            return false;
+        default:
+            return UpdateGrid(sim.dense);
+    }
+}
+
+string SimVerdict(lifeSimT &sim) {
+    return CycleVerdict(sim.cycle);
+}
+
+/*
+ * Sets up the cycle watch around the starting cells and records them, so
+ * a colony that comes back to where it began is caught on its first
+ * return.  A snapshot's restored watch replaces that record.
+ */
+
+static void StartCycle(lifeSimT &sim) {
+    switch (sim.engine) {
+        case BitEngine:
+            InitCycle(sim.cycle, sim.bits.nRows, sim.bits.nCols);
+            ToggleBits(sim, true);
+            CycleObserve(sim.cycle, sim.generation);
+            break;
+        case DenseEngine:
+            InitCycle(sim.cycle, sim.dense.nRows, sim.dense.nCols);
+            ToggleDense(sim, true);
+            CycleObserve(sim.cycle, sim.generation);
+            break;
+        case SparseEngine:
+            InitCycle(sim.cycle, 0, 0);
+            CycleObserveSparse(sim.cycle, sim.sparse, sim.generation);
+            break;
+        default:
+            InitCycle(sim.cycle, 0, 0);
+            break;
+    }
+}
+
+/*
+ * Toggles the cells born or killed by the last step, or every live cell
+ * if fromEmpty.  The standard engine knows which tiles changed and keeps
+ * the generation before in its other buffer.
+ */
+
+static inline const cellT *DenseRow(lifeStateT &state, int plane, int row) {
+    return &state.buffer[plane][(row + state.halo) * state.stride + state.halo];
+}
+
+static void ToggleDense(lifeSimT &sim, bool fromEmpty) {
+    lifeStateT &state = sim.dense;
+    for (int tr = 0; tr < state.nTileRows; tr++) {
+        for (int tc = 0; tc < state.nTileCols; tc++) {
+            if (!fromEmpty && !state.tileChanged[tr * state.nTileCols + tc]) continue;
+            int lastRow = std::min((tr + 1) * TileRows, state.nRows);
+            int lastCol = std::min((tc + 1) * TileCols, state.nCols);
+            for (int i = tr * TileRows; i < lastRow; i++) {
+                const cellT *now = DenseRow(state, state.current, i);
+                const cellT *before = DenseRow(state, 1 - state.current, i);
+                for (int j = tc * TileCols; j < lastCol; j++) {
+                    bool alive = now[j] > 0;
+                    if (alive != (!fromEmpty && before[j] > 0)) {
+                        CycleToggle(sim.cycle, i, j, alive);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/*
+ * The bit-packed engine keeps the generation before in its other live
+ * plane, so the changed cells are the set bits of the two generations xored.
+ */
+
+static void ToggleBits(lifeSimT &sim, bool fromEmpty) {
+    bitGridT &bits = sim.bits;
+    const bitWordT *now = &bits.live[bits.current][0];
+    const bitWordT *before = &bits.live[1 - bits.current][0];
+    for (int r = 0; r < bits.nRows; r++) {
+        for (int i = 0; i < bits.wordsPerRow; i++) {
+            int index = r * bits.wordsPerRow + i;
+            bitWordT changed = now[index] ^ (fromEmpty ? 0 : before[index]);
+            while (changed != 0) {
+                int b = __builtin_ctzll(changed);
+                CycleToggle(sim.cycle, r, i * BitsPerWord + b, (now[index] >> b) & 1);
+                changed &= changed - 1;
+            }
+        }
+    }
+}
+
+/*
+ * The live cells of the standard and bit-packed engines, in row order.
+ */
+
+static void DenseCells(lifeStateT &state, std::vector<sparseCellT> &cells) {
+    sparseCellT cell;
+    cell.age = 1;
+    for (cell.row = 0; cell.row < state.nRows; cell.row++) {
+        const cellT *row = DenseRow(state, state.current, cell.row);
+        for (cell.col = 0; cell.col < state.nCols; cell.col++) {
+            if (row[cell.col] > 0) cells.push_back(cell);
+        }
+    }
+}
+
+static void BitCells(bitGridT &bits, std::vector<sparseCellT> &cells) {
+    sparseCellT cell;
+    cell.age = 1;
+    for (cell.row = 0; cell.row < bits.nRows; cell.row++) {
+        const bitWordT *row = BitRow(bits, cell.row);
+        for (int i = 0; i < bits.wordsPerRow; i++) {
+            bitWordT word = row[i];
+            while (word != 0) {
+                cell.col = i * BitsPerWord + __builtin_ctzll(word);
+                cells.push_back(cell);
+                word &= word - 1;
+            }
+        }
+    }
+}
+
+/*
+ * The cycle watcher matches hashes, which can collide.  Before a repeat
+ * is believed, a copy of the engine is stepped through one more period
+ * and its cells compared with the current generation's.  This costs a
+ * period of steps once, when the run is about to end.
+ */
+
+static bool CycleHolds(lifeSimT &sim) {
+    if (sim.cycle.kind == DiedOut) return true;
+    std::vector<sparseCellT> now, later;
+    switch (sim.engine) {
+        case BitEngine: {
+            bitGridT bits = sim.bits;
+            for (int64_t k = 0; k < sim.cycle.period; k++) {
+                StepBitGrid(bits);
+            }
+            BitCells(sim.bits, now);
+            BitCells(bits, later);
+            break;
+        }
+        case SparseEngine: {
+            sparseLifeT life = sim.sparse;
+            for (int64_t k = 0; k < sim.cycle.period; k++) {
+                StepSparseLife(life);
+            }
+            now = sim.sparse.cells;
+            later = life.cells;
+            break;
+        }
+        default: {
+            lifeStateT state = sim.dense;
+            for (int64_t k = 0; k < sim.cycle.period; k++) {
+                UpdateGrid(state);
+            }
+            DenseCells(sim.dense, now);
+            DenseCells(state, later);
+            break;
+        }
+    }
+    return ConfirmCycle(sim.cycle, now, later);
+}
+
+gridLifeT &SimGrid(lifeSimT &sim) {
+    switch (sim.engine) {
+        case BitEngine:
+            BitGridToGrid(sim.bits, *sim.gridLife);
+            break;
+        case HashEngine:
+            HashLifeToGrid(sim.hash, *sim.gridLife);
+            break;
+        case SparseEngine:
+            SparseLifeToGrid(sim.sparse, *sim.gridLife);
+            break;
+        default:
+            StateToGrid(sim.dense, *sim.gridLife);
+            break;
+    }
+    return *sim.gridLife;
+}
+
+double SimPopulation(lifeSimT &sim) {
+    switch (sim.engine) {
+        case HashEngine:
+            return HashLifePopulation(sim.hash);
+        case SparseEngine:
+            return sim.sparse.cells.size();
+        case BitEngine:
+            return BitGridPopulation(sim.bits);
+        default:
+            break;
+    }
+    gridLifeT &gridLife = SimGrid(sim);
+    double population = 0;
+    for (int i = 0; i < gridLife.numRows(); i++) {
+        for (int j = 0; j < gridLife.numCols(); j++) {
+            if (gridLife[i][j] > 0) population++;
+        }
+    }
+    return population;
+}
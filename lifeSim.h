@@ -0,0 +1,93 @@
+//
+//  lifeSim.h
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+/*
+ * Defines a common front end over the stepping engines, so the
+ * simulation loop can step and draw without caring which engine
+ * is doing the work.
+ *
+ */
+
+#ifndef life_lifeSim_h
+#define life_lifeSim_h
+
+#include <stdint.h>
+
+#include "grid.h"
+#include "lifeGrid.h"
+#include "lifeBits.h"
+#include "lifeHash.h"
+#include "lifeSparse.h"
+#include "lifeCycle.h"
+
+struct lifeSimT {
+    simEngineT engine;
+    int simMode;
+    gridLifeT *gridLife;    // the starting grid, refreshed by SimGrid for drawing
+    int stepLog;            // each step is 2^stepLog generations (HashLife only)
+    int64_t generation;     // generations stepped since InitSim
+    lifeStateT dense;
+    bitGridT bits;
+    hashLifeT hash;
+    sparseLifeT sparse;
+    cycleT cycle;           // watches for the colony repeating itself
+};
+
+/*
+ * Sets up sim to step gridLife in the given simMode with the chosen engine.
+ * Infinite Mode runs on the live-cell engine unless HashLife was chosen.
+ * gridLife must outlive sim.
+ */
+
+void InitSim(lifeSimT &sim, gridLifeT &gridLife, int simMode, simEngineT engine);
+
+/*
+ * Sets up sim around engine state a loader has already filled in
+ * directly (sim.bits or sim.sparse), skipping the grid of ages.  gridLife
+ * is only used by SimGrid and may be left empty until then.
+ */
+
+void InitSimLoaded(lifeSimT &sim, gridLifeT &gridLife, int simMode, simEngineT engine);
+
+/*
+ * Advances the simulation by one generation.  Returns true when the
+ * colony has stabilized: died out, or settled into a still life, an
+ * oscillator or a spaceship (for HashLife, when a step leaves it unchanged).
+ */
+
+bool StepSim(lifeSimT &sim);
+
+/*
+ * Advances just the engine by one step, leaving the cycle watcher out, for
+ * timing the engines on their own.  Returns the engine's own stabilization
+ * test.  The watcher falls behind, so a sim stepped this way must not go
+ * back to StepSim.
+ */
+
+bool StepEngine(lifeSimT &sim);
+
+/*
+ * Describes what the colony stabilized into, once StepSim says it has.
+ */
+
+string SimVerdict(lifeSimT &sim);
+
+/*
+ * Returns the current generation as a grid of ages, ready for DrawGrid.
+ */
+
+gridLifeT &SimGrid(lifeSimT &sim);
+
+/*
+ * Returns the number of live cells.  HashLife and Infinite Mode count
+ * the whole plane, not just the window.
+ */
+
+double SimPopulation(lifeSimT &sim);
+
+#endif
@@ -0,0 +1,409 @@
+//
+//  lifeSnapshot.cpp
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+#include <cstdio>
+#include <climits>
+#include <fstream>
+#include <vector>
+
+#include "genlib.h"
+#include "grid.h"
+#include "strutils.h"
+
+#include "lifeSnapshot.h"
+#include "lifeFile.h"
+#include "lifeTrace.h"
+
+const char SnapshotMagic[] = "LIFESNAP";
+const int SnapshotMagicSize = 8;
+const uint32_t SnapshotVersion = 2;
+const int SnapshotHeaderSize = 92;
+const uint64_t ChecksumPrime = 0x100000001B3ULL;
+const uint64_t ChecksumBasis = 0xCBF29CE484222325ULL;
+
+/*
+ * The cells of a snapshot: a bitmap of mapRows by mapCols cells whose
+ * upper left cell sits at (originRow, originCol) of the window, and the
+ * ages of its live cells in row-major order.
+ */
+
+struct cellMapT {
+    int64_t originRow;
+    int64_t originCol;
+    int mapRows;
+    int mapCols;
+    int wordsPerRow;
+    std::vector<uint64_t> words;
+    std::vector<unsigned char> ages;
+};
+
+static void SizeCellMap(cellMapT &map, int mapRows, int mapCols) {
+    map.mapRows = mapRows;
+    map.mapCols = mapCols;
+    map.wordsPerRow = (mapCols + 63) / 64;
+    map.words.assign((size_t) mapRows * map.wordsPerRow, 0);
+    map.ages.clear();
+}
+
+static inline void AddCell(cellMapT &map, int row, int col, int age) {
+    map.words[(size_t) row * map.wordsPerRow + col / 64] |= uint64_t(1) << (col % 64);
+    map.ages.push_back(age);
+}
+
+/*
+ * Calls place for every live cell of map, in row-major order, with its
+ * window coordinates and age.
+ */
+
+static void PlaceCells(cellMapT &map, void (*place)(void *context, int64_t row, int64_t col, int age), void *context) {
+    size_t k = 0;
+    for (int r = 0; r < map.mapRows; r++) {
+        for (int i = 0; i < map.wordsPerRow; i++) {
+            uint64_t word = map.words[(size_t) r * map.wordsPerRow + i];
+            while (word != 0) {
+                int col = i * 64 + __builtin_ctzll(word);
+                place(context, map.originRow + r, map.originCol + col, map.ages[k++]);
+                word &= word - 1;
+            }
+        }
+    }
+}
+
+/*
+ * Checks that map holds exactly liveCells cells, none of them past its
+ * last column, so PlaceCells finds an age for every cell it places.
+ */
+
+static bool CellMapFits(cellMapT &map, uint64_t liveCells) {
+    int lastBits = map.mapCols % 64;
+    uint64_t stray = (lastBits == 0) ? 0 : ~((uint64_t(1) << lastBits) - 1);
+    uint64_t count = 0;
+    for (int r = 0; r < map.mapRows; r++) {
+        const uint64_t *row = &map.words[(size_t) r * map.wordsPerRow];
+        for (int i = 0; i < map.wordsPerRow; i++) {
+            count += __builtin_popcountll(row[i]);
+        }
+        if (map.wordsPerRow > 0 && (row[map.wordsPerRow - 1] & stray) != 0) return false;
+    }
+    return count == liveCells;
+}
+
+/*
+ * Collects the live cells of sim in snapshot form.  Returns false for
+ * HashLife, which has no ages to save.
+ */
+
+static bool GatherCells(lifeSimT &sim, cellMapT &map) {
+    map.originRow = map.originCol = 0;
+    switch (sim.engine) {
+        case HashEngine:
+            return false;
+        case BitEngine: {
+            bitGridT &bits = sim.bits;
+            SizeCellMap(map, bits.nRows, bits.nCols);
+            for (int r = 0; r < bits.nRows; r++) {
+                const bitWordT *row = BitRow(bits, r);
+                for (int i = 0; i < bits.wordsPerRow; i++) {
+                    map.words[(size_t) r * map.wordsPerRow + i] = row[i];
+                    bitWordT word = row[i];
+                    while (word != 0) {
+                        int col = i * BitsPerWord + __builtin_ctzll(word);
+                        map.ages.push_back(BitCellAge(bits, r, col));
+                        word &= word - 1;
+                    }
+                }
+            }
+            return true;
+        }
+        case SparseEngine: {
+            sparseLifeT &life = sim.sparse;
+            int top = 0, left = 0, bottom = -1, right = -1;
+            SparseLifeBounds(life, top, left, bottom, right);
+            SizeCellMap(map, bottom - top + 1, right - left + 1);
+            map.originRow = top;
+            map.originCol = left;
+            for (size_t k = 0; k < life.cells.size(); k++) {
+                AddCell(map, life.cells[k].row - top, life.cells[k].col - left, life.cells[k].age);
+            }
+            return true;
+        }
+        default: {
+            gridLifeT &gridLife = SimGrid(sim);
+            SizeCellMap(map, gridLife.numRows(), gridLife.numCols());
+            for (int i = 0; i < gridLife.numRows(); i++) {
+                for (int j = 0; j < gridLife.numCols(); j++) {
+                    if (gridLife[i][j] > 0) AddCell(map, i, j, gridLife[i][j]);
+                }
+            }
+            return true;
+        }
+    }
+}
+
+/*
+ * The window of sim.  The bit-packed and live-cell engines may have been
+ * loaded without a grid of ages, so their own dimensions are used.
+ */
+
+static void SimWindow(lifeSimT &sim, int &nRows, int &nCols) {
+    switch (sim.engine) {
+        case BitEngine:
+            nRows = sim.bits.nRows;
+            nCols = sim.bits.nCols;
+            break;
+        case SparseEngine:
+            nRows = sim.sparse.nRows;
+            nCols = sim.sparse.nCols;
+            break;
+        default:
+            nRows = sim.gridLife->numRows();
+            nCols = sim.gridLife->numCols();
+            break;
+    }
+}
+
+static uint64_t Checksum(cellMapT &map, std::vector<uint64_t> &watch) {
+    uint64_t hash = ChecksumBasis;
+    for (size_t k = 0; k < map.words.size(); k++) {
+        hash = (hash ^ map.words[k]) * ChecksumPrime;
+    }
+    for (size_t k = 0; k < map.ages.size(); k++) {
+        hash = (hash ^ map.ages[k]) * ChecksumPrime;
+    }
+    for (size_t k = 0; k < watch.size(); k++) {
+        hash = (hash ^ watch[k]) * ChecksumPrime;
+    }
+    return hash;
+}
+
+/*
+ * Little-endian fields.  The bitmap is written and read in one piece on
+ * little-endian machines and a word at a time elsewhere.
+ */
+
+static void PutField(unsigned char *&p, uint64_t value, int nBytes) {
+    for (int i = 0; i < nBytes; i++) {
+        *p++ = (value >> (8 * i)) & 0xff;
+    }
+}
+
+static uint64_t GetField(const unsigned char *&p, int nBytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < nBytes; i++) {
+        value |= uint64_t(*p++) << (8 * i);
+    }
+    return value;
+}
+
+static bool IsLittleEndian() {
+    uint16_t probe = 1;
+    return *(unsigned char *) &probe == 1;
+}
+
+static void WriteWords(ostream &out, std::vector<uint64_t> &words) {
+    if (words.empty()) return;
+    if (IsLittleEndian()) {
+        out.write((const char *) &words[0], words.size() * sizeof(uint64_t));
+        return;
+    }
+    for (size_t k = 0; k < words.size(); k++) {
+        unsigned char bytes[8], *p = bytes;
+        PutField(p, words[k], 8);
+        out.write((const char *) bytes, 8);
+    }
+}
+
+static void ReadWords(istream &input, std::vector<uint64_t> &words) {
+    if (words.empty()) return;
+    input.read((char *) &words[0], words.size() * sizeof(uint64_t));
+    if (!IsLittleEndian()) {
+        for (size_t k = 0; k < words.size(); k++) {
+            const unsigned char *p = (const unsigned char *) &words[k];
+            words[k] = GetField(p, 8);
+        }
+    }
+}
+
+bool SaveSnapshot(lifeSimT &sim, string filename) {
+    cellMapT map;
+    if (!GatherCells(sim, map)) return false;
+    int nRows, nCols;
+    SimWindow(sim, nRows, nCols);
+    std::vector<uint64_t> watch;
+    SaveCycleWatch(sim.cycle, watch);
+
+    unsigned char header[SnapshotHeaderSize], *p = header;
+    for (int i = 0; i < SnapshotMagicSize; i++) *p++ = SnapshotMagic[i];
+    PutField(p, SnapshotVersion, 4);
+    PutField(p, sim.engine, 4);
+    PutField(p, sim.simMode, 4);
+    PutField(p, nRows, 4);
+    PutField(p, nCols, 4);
+    PutField(p, sim.generation, 8);
+    PutField(p, GridRandomState(), 8);
+    PutField(p, map.originRow, 8);
+    PutField(p, map.originCol, 8);
+    PutField(p, map.mapRows, 4);
+    PutField(p, map.mapCols, 4);
+    PutField(p, map.ages.size(), 8);
+    PutField(p, watch.size(), 8);
+    PutField(p, Checksum(map, watch), 8);
+
+    ofstream out(filename.c_str(), ios::binary);
+    if (out.fail()) return false;
+    out.write((const char *) header, SnapshotHeaderSize);
+    WriteWords(out, map.words);
+    if (!map.ages.empty()) {
+        out.write((const char *) &map.ages[0], map.ages.size());
+    }
+    WriteWords(out, watch);
+    out.close();
+    return !out.fail();
+}
+
+/*
+ * Restoring, one placement function per engine.
+ */
+
+static void PlaceInGrid(void *context, int64_t row, int64_t col, int age) {
+    (*(gridLifeT *) context)[(int) row][(int) col] = age;
+}
+
+static void PlaceInBits(void *context, int64_t row, int64_t col, int age) {
+    bitGridT &bits = *(bitGridT *) context;
+    SetBitRun(bits, (int) row, (int) col, 1);
+    SetBitCellAge(bits, (int) row, (int) col, age);
+}
+
+static void PlaceInSparse(void *context, int64_t row, int64_t col, int age) {
+    sparseCellT cell;
+    cell.row = (int) row;
+    cell.col = (int) col;
+    cell.age = age;
+    ((sparseLifeT *) context)->cells.push_back(cell);
+}
+
+bool LoadSnapshot(string filename, lifeSimT &sim, gridLifeT &gridLife) {
+    TRACE_SCOPE(LoadPhase);
+    ifstream input(filename.c_str(), ios::binary);
+    if (input.fail()) return false;
+    unsigned char header[SnapshotHeaderSize];
+    input.read((char *) header, SnapshotHeaderSize);
+    if (input.gcount() != SnapshotHeaderSize) return false;
+    input.seekg(0, ios::end);
+    uint64_t bodyBytes = (uint64_t) input.tellg() - SnapshotHeaderSize;
+    input.seekg(SnapshotHeaderSize, ios::beg);
+    for (int i = 0; i < SnapshotMagicSize; i++) {
+        if (header[i] != (unsigned char) SnapshotMagic[i]) return false;
+    }
+    const unsigned char *p = header + SnapshotMagicSize;
+    if (GetField(p, 4) != SnapshotVersion) return false;
+    uint64_t engineField = GetField(p, 4);
+    uint64_t simModeField = GetField(p, 4);
+    int nRows = (int) GetField(p, 4);
+    int nCols = (int) GetField(p, 4);
+    int64_t generation = (int64_t) GetField(p, 8);
+    uint64_t randomState = GetField(p, 8);
+    cellMapT map;
+    map.originRow = (int64_t) GetField(p, 8);
+    map.originCol = (int64_t) GetField(p, 8);
+    int mapRows = (int) GetField(p, 4);
+    int mapCols = (int) GetField(p, 4);
+    uint64_t liveCells = GetField(p, 8);
+    uint64_t watchWords = GetField(p, 8);
+    uint64_t checksum = GetField(p, 8);
+
+    // Everything is checked against the header and the file's length
+    // before any of it is allocated, so a damaged header is turned away.
+    if (engineField > SparseEngine || simModeField > 3) return false;
+    simEngineT engine = (simEngineT) engineField;
+    int simMode = (int) simModeField;
+    if (engine == HashEngine || nRows < 0 || nCols < 0 || mapRows < 0 || mapCols < 0) return false;
+    if (engine != SparseEngine && (mapRows != nRows || mapCols != nCols
+                                   || map.originRow != 0 || map.originCol != 0)) return false;
+    if (map.originRow < INT_MIN || map.originRow + mapRows > INT_MAX
+        || map.originCol < INT_MIN || map.originCol + mapCols > INT_MAX) return false;
+    uint64_t mapBytes = uint64_t(mapRows) * ((mapCols + 63) / 64) * sizeof(uint64_t);
+    if (liveCells > uint64_t(mapRows) * mapCols || watchWords > uint64_t(4) * (CycleWindow + 1)
+        || mapBytes + liveCells + watchWords * sizeof(uint64_t) != bodyBytes) return false;
+
+    SizeCellMap(map, mapRows, mapCols);
+    ReadWords(input, map.words);
+    map.ages.resize(liveCells);
+    if (liveCells > 0) {
+        input.read((char *) &map.ages[0], liveCells);
+    }
+    std::vector<uint64_t> watch(watchWords);
+    ReadWords(input, watch);
+    if (input.fail() || Checksum(map, watch) != checksum || !CellMapFits(map, liveCells)) return false;
+
+    gridLife.resize(0, 0);
+    switch (engine) {
+        case BitEngine: {
+            ResizeBitGrid(sim.bits, nRows, nCols, simMode);
+            PlaceCells(map, PlaceInBits, &sim.bits);
+            InitSimLoaded(sim, gridLife, simMode, BitEngine);
+            break;
+        }
+        case SparseEngine:
+            sim.sparse.nRows = nRows;
+            sim.sparse.nCols = nCols;
+            sim.sparse.cells.clear();
+            PlaceCells(map, PlaceInSparse, &sim.sparse);
+            InitSimLoaded(sim, gridLife, simMode, SparseEngine);
+            break;
+        default:
+            gridLife.resize(nRows, nCols);
+            for (int i = 0; i < nRows; i++) {
+                for (int j = 0; j < nCols; j++) {
+                    gridLife[i][j] = 0;
+                }
+            }
+            PlaceCells(map, PlaceInGrid, &gridLife);
+            InitSim(sim, gridLife, simMode, engine);
+            break;
+    }
+    sim.generation = generation;
+    SetGridRandomState(randomState);
+    return RestoreCycleWatch(sim.cycle, watch, generation);
+}
+
+bool LoadSnapshotGrid(string filename, gridLifeT &gridLife) {
+    lifeSimT sim;
+    gridLifeT window;
+    if (!LoadSnapshot(filename, sim, window)) return false;
+    int nRows, nCols;
+    SimWindow(sim, nRows, nCols);
+    window.resize(nRows, nCols);
+    gridLife = SimGrid(sim);
+    return true;
+}
+
+bool IsSnapshotFile(string filename) {
+    string extension = ".lifesnap";
+    return filename.size() > extension.size()
+        && ConvertToLowerCase(filename.substr(filename.size() - extension.size())) == extension;
+}
+
+void InitCheckpoint(checkpointT &checkpoint, string filename, int64_t every, lifeSimT &sim) {
+    checkpoint.filename = filename;
+    checkpoint.every = (sim.engine == HashEngine) ? 0 : every;
+    checkpoint.next = (every > 0) ? (sim.generation / every + 1) * every : 0;
+}
+
+void Checkpoint(checkpointT &checkpoint, lifeSimT &sim) {
+    if (checkpoint.every <= 0 || sim.generation < checkpoint.next) return;
+    TRACE_SCOPE(CheckpointPhase);
+    while (checkpoint.next <= sim.generation) {
+        checkpoint.next += checkpoint.every;
+    }
+    string partial = checkpoint.filename + ".partial";
+    if (!SaveSnapshot(sim, partial) || rename(partial.c_str(), checkpoint.filename.c_str()) != 0) {
+        cerr << "Unable to write the checkpoint " << checkpoint.filename << endl;
+    }
+}
@@ -0,0 +1,92 @@
+//
+//  lifeSnapshot.h
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+/*
+ * Defines a binary snapshot of a running simulation, so a long run can be
+ * checkpointed and later resumed exactly where it stopped.
+ *
+ * A snapshot holds the grid size, simMode, engine, generation and the
+ * state of the random grid generator, followed by the live cells as a
+ * bitmap of 64-bit words (one row after another) and then one age byte
+ * for each live cell, in the same order.  Every field is little-endian,
+ * and a checksum over the cells catches truncated or damaged files.
+ * The cycle watcher's recent hashes (see lifeCycle.h) follow the ages, as
+ * 64-bit words, since the cells alone cannot give them back.
+ * The live-cell engine's colony may have grown past the window, so its
+ * bitmap covers the colony's bounding box and records where that sits.
+ *
+ * Restoring gives back the same cells with the same ages and the same
+ * watch for repeats, so the resumed run produces exactly the generations
+ * the original would have and stops at the same one.  HashLife
+ * keeps no ages and its plane is unbounded, so it cannot be snapshotted.
+ *
+ */
+
+#ifndef life_lifeSnapshot_h
+#define life_lifeSnapshot_h
+
+#include <stdint.h>
+
+#include "genlib.h"
+#include "grid.h"
+#include "lifeGrid.h"
+#include "lifeSim.h"
+
+/*
+ * Writes a snapshot of sim to the named file.  Returns false if the file
+ * cannot be written or sim runs on HashLife.
+ */
+
+bool SaveSnapshot(lifeSimT &sim, string filename);
+
+/*
+ * Restores the simulation saved in the named file into sim, on the engine
+ * and in the simMode it was saved with.  gridLife becomes the window that
+ * SimGrid exports to; it is only filled in for the standard engine and
+ * is otherwise left empty, to be sized by the caller when needed.  Returns
+ * false if the file cannot be read or is not a valid snapshot.
+ */
+
+bool LoadSnapshot(string filename, lifeSimT &sim, gridLifeT &gridLife);
+
+/*
+ * Reads just the window of the saved simulation, as a grid of ages.
+ */
+
+bool LoadSnapshotGrid(string filename, gridLifeT &gridLife);
+
+/*
+ * Returns true if filename names a snapshot (by its .lifesnap extension).
+ */
+
+bool IsSnapshotFile(string filename);
+
+/*
+ * Type: checkpointT
+ * -----------------
+ * Saves a snapshot automatically every so many generations.  Each
+ * checkpoint is written beside the file and then renamed over it, so an
+ * interruption mid-write leaves the previous checkpoint intact.  They are
+ * turned off for HashLife.
+ */
+
+struct checkpointT {
+    string filename;
+    int64_t every;          // generations between checkpoints; 0 turns them off
+    int64_t next;           // generation due for the next checkpoint
+};
+
+void InitCheckpoint(checkpointT &checkpoint, string filename, int64_t every, lifeSimT &sim);
+
+/*
+ * Saves a checkpoint if sim has reached the generation due for one.
+ */
+
+void Checkpoint(checkpointT &checkpoint, lifeSimT &sim);
+
+#endif
@@ -0,0 +1,168 @@
+//
+//  lifeSparse.cpp
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+#include <climits>
+
+#include "genlib.h"
+#include "grid.h"
+
+#include "lifeSparse.h"
+#include "lifeGraphics.h"
+
+static void MergeRows(sparseLifeT &life, int a, int aEnd, int b, int bEnd, int c, int cEnd);
+static bool StepRow(sparseLifeT &life, int row, int self, int selfEnd);
+
+void InitSparseLife(sparseLifeT &life, gridLifeT &gridLife) {
+    life.nRows = gridLife.numRows();
+    life.nCols = gridLife.numCols();
+    life.cells.clear();
+    for (int i = 0; i < life.nRows; i++) {
+        for (int j = 0; j < life.nCols; j++) {
+            if (gridLife[i][j] > 0) {
+                sparseCellT cell;
+                cell.row = i;
+                cell.col = j;
+                cell.age = (gridLife[i][j] < MaxAge) ? gridLife[i][j] : MaxAge;
+                life.cells.push_back(cell);
+            }
+        }
+    }
+}
+
+/*
+ * Finds where the run of cells for the given row starts and ends,
+ * searching forward from index from.  The run is empty if start == end.
+ */
+
+static void FindRow(sparseLifeT &life, int row, int from, int &start, int &end) {
+    int n = (int) life.cells.size();
+    start = from;
+    while (start < n && life.cells[start].row < row) start++;
+    end = start;
+    while (end < n && life.cells[end].row == row) end++;
+}
+
+/*
+ * Only rows next to a row with live cells can hold live cells next
+ * generation.  Rows are visited in order, and for each the runs of the
+ * row above, the row itself and the row below are found by moving three
+ * indexes forward through the sorted cell list.
+ */
+
+bool StepSparseLife(sparseLifeT &life) {
+    life.next.clear();
+    bool young = false;
+    int n = (int) life.cells.size();
+    int up = 0, self = 0, down = 0;
+    int lastRow = 0;
+    bool first = true;
+
+    for (int k = 0; k < n; ) {
+        int liveRow = life.cells[k].row;
+        for (int row = liveRow - 1; row <= liveRow + 1; row++) {
+            if (!first && row <= lastRow) continue;
+            first = false;
+            lastRow = row;
+            int upStart, upEnd, selfStart, selfEnd, downStart, downEnd;
+            FindRow(life, row - 1, up, upStart, upEnd);
+            FindRow(life, row, self, selfStart, selfEnd);
+            FindRow(life, row + 1, down, downStart, downEnd);
+            up = upStart;
+            self = selfStart;
+            down = downStart;
+            MergeRows(life, upStart, upEnd, selfStart, selfEnd, downStart, downEnd);
+            young |= StepRow(life, row, selfStart, selfEnd);
+        }
+        while (k < n && life.cells[k].row == liveRow) k++;
+    }
+    life.cells.swap(life.next);
+    return !young;
+}
+
+/*
+ * Merges the columns of three sorted runs of cells into life.merged,
+ * keeping duplicates, and lists every column within one of them in
+ * life.candidates, in order and without repeats.
+ */
+
+static void MergeRows(sparseLifeT &life, int a, int aEnd, int b, int bEnd, int c, int cEnd) {
+    life.merged.clear();
+    life.candidates.clear();
+    while (a < aEnd || b < bEnd || c < cEnd) {
+        int col;
+        int *from;
+        int colA = (a < aEnd) ? life.cells[a].col : INT_MAX;
+        int colB = (b < bEnd) ? life.cells[b].col : INT_MAX;
+        int colC = (c < cEnd) ? life.cells[c].col : INT_MAX;
+        if (colA <= colB && colA <= colC) { col = colA; from = &a; }
+        else if (colB <= colC) { col = colB; from = &b; }
+        else { col = colC; from = &c; }
+        (*from)++;
+        life.merged.push_back(col);
+        for (int x = col - 1; x <= col + 1; x++) {
+            if (life.candidates.empty() || x > life.candidates.back()) {
+                life.candidates.push_back(x);
+            }
+        }
+    }
+}
+
+/*
+ * Decides every candidate column of the given row.  A window [lo, hi) over
+ * the merged columns holds the live cells within one column of the
+ * candidate; subtracting the candidate itself leaves its neighbor count.
+ */
+
+static bool StepRow(sparseLifeT &life, int row, int self, int selfEnd) {
+    bool young = false;
+    int lo = 0, hi = 0;
+    int m = (int) life.merged.size();
+    for (int k = 0; k < (int) life.candidates.size(); k++) {
+        int x = life.candidates[k];
+        while (lo < m && life.merged[lo] < x - 1) lo++;
+        while (hi < m && life.merged[hi] <= x + 1) hi++;
+        while (self < selfEnd && life.cells[self].col < x) self++;
+        int age = (self < selfEnd && life.cells[self].col == x) ? life.cells[self].age : 0;
+        int neighbors = hi - lo - (age > 0);
+        if (neighbors == 3 || (neighbors == 2 && age > 0)) {
+            sparseCellT cell;
+            cell.row = row;
+            cell.col = x;
+            cell.age = (age < MaxAge) ? age + 1 : MaxAge;
+            life.next.push_back(cell);
+            young = young || cell.age < MaxAge;
+        }
+    }
+    return young;
+}
+
+void SparseLifeToGrid(sparseLifeT &life, gridLifeT &gridLife) {
+    for (int i = 0; i < gridLife.numRows(); i++) {
+        for (int j = 0; j < gridLife.numCols(); j++) {
+            gridLife[i][j] = 0;
+        }
+    }
+    for (int k = 0; k < (int) life.cells.size(); k++) {
+        sparseCellT &cell = life.cells[k];
+        if (gridLife.inBounds(cell.row, cell.col)) {
+            gridLife[cell.row][cell.col] = cell.age;
+        }
+    }
+}
+
+bool SparseLifeBounds(sparseLifeT &life, int &top, int &left, int &bottom, int &right) {
+    if (life.cells.empty()) return false;
+    top = life.cells.front().row;
+    bottom = life.cells.back().row;
+    left = right = life.cells.front().col;
+    for (int k = 0; k < (int) life.cells.size(); k++) {
+        if (life.cells[k].col < left) left = life.cells[k].col;
+        if (life.cells[k].col > right) right = life.cells[k].col;
+    }
+    return true;
+}
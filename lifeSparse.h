@@ -0,0 +1,72 @@
+//
+//  lifeSparse.h
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+/*
+ * Defines the live-cell engine behind Infinite Mode.  Only live cells
+ * are stored, as a list sorted by row and then column, so the plane has
+ * no edges and memory grows with the population rather than the area.
+ *
+ * Each generation is computed a row at a time: the live cells of the
+ * rows above, at and below are merged into one sorted run of columns,
+ * and a sliding window over that run counts the neighbors of every
+ * cell that could be alive next.  Nothing is hashed or sorted, and the
+ * output comes out already in order.
+ *
+ */
+
+#ifndef life_lifeSparse_h
+#define life_lifeSparse_h
+
+#include <vector>
+
+#include "grid.h"
+#include "lifeGrid.h"
+
+struct sparseCellT {
+    int row;
+    int col;
+    int age;
+};
+
+struct sparseLifeT {
+    std::vector<sparseCellT> cells;     // live cells, sorted by row then column
+    std::vector<sparseCellT> next;      // the generation being built
+    std::vector<int> merged;            // scratch: columns of three rows
+    std::vector<int> candidates;        // scratch: columns that may be alive next
+    int nRows;                          // size of the window SparseLifeToGrid fills
+    int nCols;
+};
+
+/*
+ * Collects the live cells of gridLife.  Its rectangle becomes the window
+ * SparseLifeToGrid exports, with (0, 0) at its upper left.
+ */
+
+void InitSparseLife(sparseLifeT &life, gridLifeT &gridLife);
+
+/*
+ * Advances the plane by one generation.  Returns true when every live
+ * cell has reached MaxAge, as UpdateGrid does.
+ */
+
+bool StepSparseLife(sparseLifeT &life);
+
+/*
+ * Copies the cells inside the window into gridLife.
+ */
+
+void SparseLifeToGrid(sparseLifeT &life, gridLifeT &gridLife);
+
+/*
+ * Finds the smallest rectangle holding every live cell.  Returns false
+ * if there are none.
+ */
+
+bool SparseLifeBounds(sparseLifeT &life, int &top, int &left, int &bottom, int &right);
+
+#endif
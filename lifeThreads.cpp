@@ -0,0 +1,166 @@
+//
+//  lifeThreads.cpp
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+#include <pthread.h>
+#include <unistd.h>
+#include <vector>
+
+#include "lifeThreads.h"
+
+/*
+ * Pool state.  Work is handed out by bumping poolRound under poolLock and
+ * broadcasting poolWake; each worker sleeps until the round moves past the
+ * last one it ran.  poolBusy counts the workers still running the current
+ * round, and the last one to finish signals poolDone.
+ */
+
+static pthread_mutex_t poolLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t poolWake = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t poolDone = PTHREAD_COND_INITIALIZER;
+static std::vector<pthread_t> poolThreads;
+static unsigned long poolRound = 0;
+static unsigned long poolStartRound = 0;
+static int poolBusy = 0;
+static bool poolQuitting = false;
+static workerFnT poolWork = NULL;
+static void *poolContext = NULL;
+static int wantedWorkers = 0;
+
+static void *WorkerMain(void *arg);
+static void StartPool(int nWorkers);
+static void StopPool();
+
+void SetWorkerCount(int nWorkers) {
+    if (nWorkers < 0) nWorkers = 0;
+    if (nWorkers > MaxWorkers) nWorkers = MaxWorkers;
+    if (nWorkers != wantedWorkers) {
+        StopPool();
+        wantedWorkers = nWorkers;
+    }
+}
+
+int WorkerCount() {
+    if (wantedWorkers > 0) return wantedWorkers;
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    if (online < 1) return 1;
+    return (online > MaxWorkers) ? MaxWorkers : (int) online;
+}
+
+void RunWorkers(workerFnT work, void *context) {
+    int nWorkers = WorkerCount();
+    if (nWorkers == 1) {
+        work(context, 0, 1);
+        return;
+    }
+    if ((int) poolThreads.size() != nWorkers - 1) {
+        StopPool();
+        StartPool(nWorkers);
+    }
+    pthread_mutex_lock(&poolLock);
+    poolWork = work;
+    poolContext = context;
+    poolBusy = nWorkers - 1;
+    poolRound++;
+    pthread_cond_broadcast(&poolWake);
+    pthread_mutex_unlock(&poolLock);
+
+    work(context, 0, nWorkers);
+
+    pthread_mutex_lock(&poolLock);
+    while (poolBusy > 0) {
+        pthread_cond_wait(&poolDone, &poolLock);
+    }
+    pthread_mutex_unlock(&poolLock);
+}
+
+static void *WorkerMain(void *arg) {
+    int worker = (int) (long) arg;
+    pthread_mutex_lock(&poolLock);
+    unsigned long seen = poolStartRound;
+    while (true) {
+        while (poolRound == seen && !poolQuitting) {
+            pthread_cond_wait(&poolWake, &poolLock);
+        }
+        if (poolQuitting) break;
+        seen = poolRound;
+        workerFnT work = poolWork;
+        void *context = poolContext;
+        int nWorkers = (int) poolThreads.size() + 1;
+        pthread_mutex_unlock(&poolLock);
+
+        work(context, worker, nWorkers);
+
+        pthread_mutex_lock(&poolLock);
+        if (--poolBusy == 0) {
+            pthread_cond_signal(&poolDone);
+        }
+    }
+    pthread_mutex_unlock(&poolLock);
+    return NULL;
+}
+
+static void StartPool(int nWorkers) {
+    pthread_mutex_lock(&poolLock);
+    poolQuitting = false;
+    poolStartRound = poolRound;
+    poolThreads.resize(nWorkers - 1);
+    for (int k = 1; k < nWorkers; k++) {
+        pthread_create(&poolThreads[k - 1], NULL, WorkerMain, (void *) (long) k);
+    }
+    pthread_mutex_unlock(&poolLock);
+}
+
+static void StopPool() {
+    if (poolThreads.empty()) return;
+    pthread_mutex_lock(&poolLock);
+    poolQuitting = true;
+    pthread_cond_broadcast(&poolWake);
+    pthread_mutex_unlock(&poolLock);
+    for (int k = 0; k < (int) poolThreads.size(); k++) {
+        pthread_join(poolThreads[k], NULL);
+    }
+    poolThreads.clear();
+}
+
+/*
+ * The waiting slot and its fresh flag share one word, so each side claims
+ * it by swapping in its own slot with a single compare-and-swap, which is
+ * also a full memory barrier: the frame written into a slot is visible
+ * before the slot can be acquired.
+ */
+
+const int SlotMask = 3;
+const int FreshSlot = 4;
+
+void InitTripleBuffer(tripleBufferT &buffer) {
+    buffer.front = 0;
+    buffer.state = 1;
+    buffer.back = 2;
+}
+
+void PublishSlot(tripleBufferT &buffer) {
+    int old = __sync_fetch_and_add(&buffer.state, 0);
+    while (true) {
+        int seen = __sync_val_compare_and_swap(&buffer.state, old, buffer.back | FreshSlot);
+        if (seen == old) break;
+        old = seen;
+    }
+    buffer.back = old & SlotMask;
+}
+
+bool AcquireSlot(tripleBufferT &buffer) {
+    int old = __sync_fetch_and_add(&buffer.state, 0);
+    while (true) {
+        if (!(old & FreshSlot)) return false;
+        int seen = __sync_val_compare_and_swap(&buffer.state, old, buffer.front);
+        if (seen == old) break;
+        old = seen;
+    }
+    buffer.front = old & SlotMask;
+    return true;
+}
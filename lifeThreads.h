@@ -0,0 +1,91 @@
+//
+//  lifeThreads.h
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+/*
+ * Defines a persistent pool of worker threads.  The threads are started
+ * the first time work is handed out and then sleep between rounds, so a
+ * simulation pays for thread creation once rather than every generation.
+ *
+ * Also defines a lock-free triple buffer for handing finished generations
+ * from a simulation thread to the thread drawing them.
+ *
+ */
+
+#ifndef life_lifeThreads_h
+#define life_lifeThreads_h
+
+/*
+ * Upper limit on the number of workers, and the cache line size used to
+ * keep per-worker results apart.
+ */
+
+const int MaxWorkers = 256;
+const int CacheLineSize = 64;
+
+/*
+ * Type: workerFnT
+ * ---------------
+ * One worker's share of a round.  It is called once for each worker from
+ * 0 to nWorkers - 1, each on its own thread, with the same context.
+ */
+
+typedef void (*workerFnT)(void *context, int worker, int nWorkers);
+
+/*
+ * Sets how many workers share a round, counting the calling thread.
+ * Passing 0 uses one worker per online processor.
+ */
+
+void SetWorkerCount(int nWorkers);
+
+/*
+ * Returns how many workers share a round.
+ */
+
+int WorkerCount();
+
+/*
+ * Runs work for every worker and returns when all of them have finished,
+ * which makes each call a barrier.  The calling thread acts as worker 0.
+ */
+
+void RunWorkers(workerFnT work, void *context);
+
+/*
+ * Type: tripleBufferT
+ * -------------------
+ * Passes whole frames from one producer thread to one consumer thread
+ * without locking.  The caller keeps three slots, numbered 0 to 2: the
+ * producer fills its back slot, the consumer reads its front slot, and the
+ * third slot is the newest published frame waiting between them.  Neither
+ * side ever waits; a consumer that falls behind skips straight to the
+ * newest frame.
+ */
+
+struct tripleBufferT {
+    volatile int state;     // the waiting slot, plus a flag once it is fresh
+    int back;               // owned by the producer
+    int front;              // owned by the consumer
+};
+
+void InitTripleBuffer(tripleBufferT &buffer);
+
+/*
+ * Producer: publishes the filled back slot and takes a new back slot.
+ */
+
+void PublishSlot(tripleBufferT &buffer);
+
+/*
+ * Consumer: moves front to the newest published slot.  Returns false,
+ * leaving front alone, if nothing new was published since the last call.
+ */
+
+bool AcquireSlot(tripleBufferT &buffer);
+
+#endif
@@ -0,0 +1,186 @@
+//
+//  lifeTrace.cpp
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <vector>
+
+#include "genlib.h"
+
+#include "lifeTrace.h"
+
+const int MaxTraceThreads = 512;
+
+static const char *PhaseNames[NumTracePhases] = {
+    "step", "draw", "pause", "input", "load", "checkpoint"
+};
+
+/*
+ * Events are written into slots claimed with an atomic increment, so
+ * threads never wait on each other.  A counter event has no phase.
+ */
+
+struct traceEventT {
+    int64_t start;          // nanoseconds since the trace began
+    int64_t duration;
+    double value;           // counters only
+    const char *name;       // counters only
+    short phase;            // -1 for a counter
+    short thread;
+};
+
+struct phaseTotalsT {
+    int64_t calls;
+    int64_t total;          // nanoseconds
+    int64_t longest;
+};
+
+bool traceEnabled = false;
+
+static string traceFile;
+static std::vector<traceEventT> events;
+static int traceCapacity = 0;
+static volatile int64_t nextEvent = 0;   // keeps counting past the buffer
+static phaseTotalsT totals[NumTracePhases];
+static int64_t traceBegan = 0;
+static int64_t traceEnded = 0;
+static volatile int threadCount = 0;
+static const char *threadNames[MaxTraceThreads];
+static __thread int traceThread = -1;
+
+int64_t TraceClock() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return int64_t(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+static int ThisThread() {
+    if (traceThread < 0) {
+        traceThread = __sync_fetch_and_add(&threadCount, 1) % MaxTraceThreads;
+    }
+    return traceThread;
+}
+
+static traceEventT *ClaimEvent() {
+    int64_t slot = __sync_fetch_and_add(&nextEvent, 1);
+    return (slot < traceCapacity) ? &events[slot] : NULL;
+}
+
+bool StartTrace(string filename, int maxEvents) {
+    if (!LIFE_TRACE) return false;
+    traceFile = filename;
+    events.assign(maxEvents, traceEventT());
+    traceCapacity = maxEvents;
+    nextEvent = 0;
+    for (int k = 0; k < NumTracePhases; k++) {
+        totals[k].calls = totals[k].total = totals[k].longest = 0;
+    }
+    traceBegan = TraceClock();
+    traceEnded = 0;
+    traceEnabled = true;
+    return true;
+}
+
+void TraceThreadName(const char *name) {
+    threadNames[ThisThread()] = name;
+}
+
+void TraceRecord(tracePhaseT phase, int64_t start, int64_t end) {
+    int64_t elapsed = end - start;
+    phaseTotalsT &phaseTotals = totals[phase];
+    __sync_fetch_and_add(&phaseTotals.calls, 1);
+    __sync_fetch_and_add(&phaseTotals.total, elapsed);
+    int64_t longest = phaseTotals.longest;
+    while (elapsed > longest && !__sync_bool_compare_and_swap(&phaseTotals.longest, longest, elapsed)) {
+        longest = phaseTotals.longest;
+    }
+    traceEventT *event = ClaimEvent();
+    if (event == NULL) return;
+    event->start = start - traceBegan;
+    event->duration = elapsed;
+    event->phase = phase;
+    event->thread = ThisThread();
+}
+
+void TraceCounter(const char *name, double value) {
+    traceEventT *event = ClaimEvent();
+    if (event == NULL) return;
+    event->start = TraceClock() - traceBegan;
+    event->value = value;
+    event->name = name;
+    event->phase = -1;
+    event->thread = ThisThread();
+}
+
+/*
+ * Chrome trace times are in microseconds; three decimals keep the
+ * nanoseconds.
+ */
+
+static string Micros(int64_t nanos) {
+    char text[32];
+    sprintf(text, "%.3f", nanos / 1000.0);
+    return text;
+}
+
+bool StopTrace() {
+    if (!traceEnabled) return false;
+    traceEnabled = false;
+    traceEnded = TraceClock();
+
+    ofstream out(traceFile.c_str());
+    if (out.fail()) return false;
+    int nEvents = (int) std::min<int64_t>((int64_t) nextEvent, traceCapacity);
+    out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [" << endl;
+    int nThreads = std::min((int) threadCount, MaxTraceThreads);
+    for (int t = 0; t < nThreads; t++) {
+        if (threadNames[t] == NULL) continue;
+        out << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << t
+            << ", \"args\": {\"name\": \"" << threadNames[t] << "\"}}," << endl;
+    }
+    for (int k = 0; k < nEvents; k++) {
+        traceEventT &event = events[k];
+        if (event.phase >= 0) {
+            out << "{\"name\": \"" << PhaseNames[event.phase] << "\", \"cat\": \"life\", \"ph\": \"X\", \"ts\": "
+                << Micros(event.start) << ", \"dur\": " << Micros(event.duration)
+                << ", \"pid\": 1, \"tid\": " << event.thread << "}";
+        }
+        else {
+            out << "{\"name\": \"" << event.name << "\", \"ph\": \"C\", \"ts\": " << Micros(event.start)
+                << ", \"pid\": 1, \"tid\": " << event.thread << ", \"args\": {\"value\": " << event.value << "}}";
+        }
+        out << ((k + 1 < nEvents) ? "," : "") << endl;
+    }
+    out << "]}" << endl;
+    events.clear();
+    return !out.fail();
+}
+
+void PrintTraceSummary(ostream &out) {
+    double wall = ((traceEnded ? traceEnded : TraceClock()) - traceBegan) / 1e9;
+    char line[128];
+    sprintf(line, "# %-10s %10s %12s %10s %10s %7s", "phase", "calls", "total ms", "mean us", "max us", "wall");
+    out << line << endl;
+    for (int k = 0; k < NumTracePhases; k++) {
+        phaseTotalsT &phaseTotals = totals[k];
+        if (phaseTotals.calls == 0) continue;
+        sprintf(line, "# %-10s %10lld %12.3f %10.3f %10.3f %6.1f%%", PhaseNames[k], (long long) phaseTotals.calls,
+                phaseTotals.total / 1e6, phaseTotals.total / 1e3 / phaseTotals.calls, phaseTotals.longest / 1e3,
+                (wall > 0) ? 100 * phaseTotals.total / 1e9 / wall : 0.0);
+        out << line << endl;
+    }
+    int64_t dropped = nextEvent - traceCapacity;
+    sprintf(line, "# %.3f ms traced", wall * 1e3);
+    out << line;
+    if (dropped > 0) {
+        out << ", " << dropped << " events past the buffer left out of the trace file";
+    }
+    out << endl;
+}
@@ -0,0 +1,127 @@
+//
+//  lifeTrace.h
+//  life
+//
+//  Created by Vince Mansel on 10/16/26.
+//  Copyright 2026 Wave Ocean Networks. All rights reserved.
+//
+
+/*
+ * Defines built-in timers for the phases of a run (stepping, drawing,
+ * pausing, polling for input, loading patterns and checkpointing), so
+ * where the time goes can be seen without attaching a profiler.
+ *
+ * A phase is timed by putting TRACE_SCOPE(phase) at the top of the block
+ * doing the work, and a value worth following over time (active tiles,
+ * frames shown) is recorded with TRACE_COUNT(name, value).  Nothing is
+ * recorded until StartTrace is called; until then each scope costs one
+ * test of a flag.  StopTrace saves what was recorded as Chrome trace-event
+ * JSON, which chrome://tracing or Perfetto can open, and PrintTraceSummary
+ * gives the totals for each phase.
+ *
+ * Building with LIFE_TRACE defined as 0 compiles the scopes and counters
+ * out altogether, and StartTrace then refuses to start.
+ *
+ */
+
+#ifndef life_lifeTrace_h
+#define life_lifeTrace_h
+
+#include <stdint.h>
+#include <iostream>
+
+#include "genlib.h"
+
+#ifndef LIFE_TRACE
+#define LIFE_TRACE 1
+#endif
+
+enum tracePhaseT {
+    StepPhase,
+    DrawPhase,
+    PausePhase,
+    InputPhase,             // mouse polls and console reads
+    LoadPhase,
+    CheckpointPhase,
+    NumTracePhases
+};
+
+/*
+ * Events kept for the trace file by default.  Once the buffer is full,
+ * later events only count towards the summary.
+ */
+
+const int TraceMaxEvents = 1 << 18;
+
+/*
+ * Set while a trace is being recorded.  Only StartTrace and StopTrace
+ * change it, and never while traced threads are running.
+ */
+
+extern bool traceEnabled;
+
+/*
+ * Starts recording, to be saved to filename by StopTrace.  Returns false
+ * if tracing was compiled out.
+ */
+
+bool StartTrace(string filename, int maxEvents = TraceMaxEvents);
+
+/*
+ * Stops recording and saves the events as Chrome trace-event JSON.
+ * Returns false if the file cannot be written.  The summary stays
+ * available until the next StartTrace.
+ */
+
+bool StopTrace();
+
+/*
+ * Prints, for each phase, how often it ran, its total, mean and longest
+ * times and its share of the wall time the trace covered.
+ */
+
+void PrintTraceSummary(ostream &out);
+
+/*
+ * Names the calling thread in the trace file, e.g. "simulation".
+ */
+
+void TraceThreadName(const char *name);
+
+/*
+ * Records one finished phase, or one counter value, for the calling
+ * thread.  Used by the macros below; times come from TraceClock.
+ */
+
+int64_t TraceClock();
+void TraceRecord(tracePhaseT phase, int64_t start, int64_t end);
+void TraceCounter(const char *name, double value);
+
+/*
+ * Type: traceScopeT
+ * -----------------
+ * Times the block it is declared in, if a trace was running as the
+ * block was entered.
+ */
+
+struct traceScopeT {
+    tracePhaseT phase;
+    int64_t start;
+
+    traceScopeT(tracePhaseT phase) : phase(phase), start(traceEnabled ? TraceClock() : -1) {}
+    ~traceScopeT() {
+        if (start >= 0) TraceRecord(phase, start, TraceClock());
+    }
+};
+
+#if LIFE_TRACE
+#define TRACE_JOIN2(a, b) a##b
+#define TRACE_JOIN(a, b) TRACE_JOIN2(a, b)
+#define TRACE_SCOPE(phase) traceScopeT TRACE_JOIN(traceScope, __LINE__)(phase)
+#define TRACE_COUNT(name, value) do { if (traceEnabled) TraceCounter(name, value); } while (0)
+#else
+#define TRACE_SCOPE(phase) ((void) 0)
+#define TRACE_COUNT(name, value) ((void) 0)
+#endif
+
+#endif